@@ -0,0 +1,115 @@
+#include "asymmetric_arbiter.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <new>
+#include <thread>
+
+AsymmetricArbiter::AsymmetricArbiter(int numPhilosophers)
+    : ForkArbiter(numPhilosophers),
+      topology_(NumaTopology::detect()),
+      shards_(topology_.nodes()),
+      forks_(numPhilosophers) {
+  // Страницы отображения ещё не тронуты: память под них ядро выделит на
+  // узле того потока, который первым в них запишет
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  for (int node = 0; node < topology_.nodes(); ++node) {
+    Shard& shard = shards_[node];
+    shard.count = topology_.firstSeat(node + 1, numPhilosophers) -
+                  topology_.firstSeat(node, numPhilosophers);
+    if (shard.count == 0) continue;
+    shard.bytes =
+        (shard.count * sizeof(ForkSlot) + page - 1) / page * page;
+    void* memory = mmap(nullptr, shard.bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    shard.slots = (ForkSlot*)memory;
+  }
+
+  if (topology_.nodes() == 1) {
+    placeShard(0);
+    return;
+  }
+  for (int node = 0; node < topology_.nodes(); ++node) {
+    std::thread([this, node] {
+      topology_.bindThread(node);
+      placeShard(node);
+    }).join();
+  }
+}
+
+AsymmetricArbiter::Shard::~Shard() {
+  if (!slots) return;
+  for (int i = 0; i < placed; ++i) {
+    slots[i].~ForkSlot();
+  }
+  munmap(slots, bytes);
+}
+
+void AsymmetricArbiter::placeShard(int node) {
+  Shard& shard = shards_[node];
+  int first = topology_.firstSeat(node, numPhilosophers_);
+  for (int i = 0; i < shard.count; ++i) {
+    forks_[first + i] = &(new (&shard.slots[i]) ForkSlot)->lock;
+  }
+  shard.placed = shard.count;
+}
+
+bool AsymmetricArbiter::acquire(int philosopher,
+                                const CancellationToken& running,
+                                const EventReporter& report) {
+  int first = firstFork(philosopher);
+  int second = secondFork(philosopher);
+
+  // Берем первую вилку
+  if (!take(first, report)) {
+    return false;
+  }
+  if (!running) {
+    forks_[first]->unlock();
+    return false;
+  }
+
+  // Берем вторую вилку
+  if (!take(second, report)) {
+    forks_[first]->unlock();
+    return false;
+  }
+  return true;
+}
+
+bool AsymmetricArbiter::take(int fork, const EventReporter& report) {
+  report(EventType::TakeFork, fork);
+  if (forks_[fork]->tryLock()) {
+    return true;
+  }
+  report(EventType::ForkBusy, fork);
+  return forks_[fork]->lock();
+}
+
+void AsymmetricArbiter::release(int philosopher) {
+  forks_[secondFork(philosopher)]->unlock();
+  forks_[firstFork(philosopher)]->unlock();
+}
+
+void AsymmetricArbiter::cancel() {
+  for (FutexForkLock* fork : forks_) {
+    fork->cancel();
+  }
+}
+
+// На машине с одним узлом привязка ничего не даёт и только мешала бы
+// планировщику
+void AsymmetricArbiter::bindThread(int philosopher) {
+  if (topology_.nodes() > 1) {
+    topology_.bindThread(topology_.nodeOfSeat(philosopher, numPhilosophers_));
+  }
+}
+
+bool AsymmetricArbiter::virtualProtocol(VirtualProtocol& protocol) const {
+  protocol = {false, false, false, true};
+  return true;
+}
@@ -0,0 +1,73 @@
+#ifndef ENGINE_ASYMMETRIC_ARBITER_H
+#define ENGINE_ASYMMETRIC_ARBITER_H
+
+#include <vector>
+
+#include "fork_arbiter.h"
+#include "fork_lock.h"
+#include "numa_topology.h"
+
+// Асимметричный захват: чётные места берут сначала левую вилку, нечётные -
+// правую. Общая вилка 1 мест 0 и 1 - вторая для обоих: кто её держит, тот
+// уже взял и первую и ест, а значит, вилку отдаст. Цепочка ожидания не
+// проходит через вилку 1 и не замыкается вокруг стола, поэтому блокировщик
+// не нужен. (У пар нечётное-чётное место, наоборот, общая вилка - первая
+// для обоих, и проигравший ждёт её, ничего не держа.)
+// Для больших столов вилки разложены по узлам NUMA: места делятся на
+// непрерывные диапазоны по узлам, вилки диапазона лежат в своих страницах,
+// которые первым касается поток, привязанный к узлу, а потоки философов
+// привязываются к узлу своего места (bindThread).
+class AsymmetricArbiter : public ForkArbiter {
+ public:
+  explicit AsymmetricArbiter(int numPhilosophers);
+  AsymmetricArbiter(const AsymmetricArbiter&) = delete;
+  AsymmetricArbiter& operator=(const AsymmetricArbiter&) = delete;
+
+  const char* name() const override { return "asymmetric"; }
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override;
+  void release(int philosopher) override;
+  void cancel() override;
+  void bindThread(int philosopher) override;
+  bool virtualProtocol(VirtualProtocol& protocol) const override;
+
+ private:
+  struct alignas(64) ForkSlot {
+    FutexForkLock lock;
+  };
+
+  // Вилки одного узла в отдельном отображении mmap. Владеет отображением:
+  // если конструктор арбитра бросит исключение, уже созданные отображения
+  // освободятся вместе с shards_.
+  struct Shard {
+    Shard() = default;
+    ~Shard();
+    Shard(const Shard&) = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    ForkSlot* slots = nullptr;
+    int count = 0;
+    int placed = 0;  // сколько слотов уже построено
+    size_t bytes = 0;
+  };
+
+  int firstFork(int philosopher) const {
+    return philosopher % 2 == 0 ? leftFork(philosopher)
+                                : rightFork(philosopher);
+  }
+  int secondFork(int philosopher) const {
+    return philosopher % 2 == 0 ? rightFork(philosopher)
+                                : leftFork(philosopher);
+  }
+  // Берёт вилку; занятая вилка отмечается событием ForkBusy. Возвращает
+  // false при отмене.
+  bool take(int fork, const EventReporter& report);
+  // Размещает вилки узла node, пока поток привязан к этому узлу
+  void placeShard(int node);
+
+  NumaTopology topology_;
+  std::vector<Shard> shards_;
+  std::vector<FutexForkLock*> forks_;
+};
+
+#endif  // ENGINE_ASYMMETRIC_ARBITER_H
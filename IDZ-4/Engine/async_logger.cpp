@@ -0,0 +1,197 @@
+#include "async_logger.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+thread_local AsyncLogger::Ring* AsyncLogger::localRing_ = nullptr;
+thread_local uint64_t AsyncLogger::localOwner_ = 0;
+
+namespace {
+
+// Пауза потока вывода, когда все буферы пусты
+const auto IDLE_SLEEP = std::chrono::milliseconds(1);
+
+std::atomic<uint64_t> nextLoggerId{1};
+
+}  // namespace
+
+AsyncLogger::AsyncLogger(size_t ringCapacity)
+    : id_(nextLoggerId++),
+      // Самая длинная запись должна поместиться и после пропуска остатка
+      ringCapacity_(std::max((ringCapacity + 7) / 8 * 8,
+                             2 * recordSize(MAX_MESSAGE))),
+      startTime_(std::chrono::steady_clock::now()) {}
+
+AsyncLogger::~AsyncLogger() {
+  stop();
+  if (fileFd_ >= 0) {
+    close(fileFd_);
+  }
+  Ring* ring = rings_.load();
+  while (ring != nullptr) {
+    Ring* next = ring->next;
+    delete ring;
+    ring = next;
+  }
+}
+
+bool AsyncLogger::openFile(const std::string& path) {
+  fileFd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  return fileFd_ >= 0;
+}
+
+void AsyncLogger::start() {
+  startTime_ = std::chrono::steady_clock::now();
+  running_ = true;
+  drainThread_ = std::thread(&AsyncLogger::drainLoop, this);
+}
+
+void AsyncLogger::stop() {
+  if (!drainThread_.joinable()) {
+    return;
+  }
+  running_ = false;
+  drainThread_.join();
+}
+
+void AsyncLogger::log(const std::string& message) {
+  Ring* ring = localRing();
+  size_t length = std::min(message.size(), MAX_MESSAGE);
+  size_t size = recordSize(length);
+  size_t capacity = ring->capacity();
+  uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+  // Запись не помещается до края буфера: остаток пропускается
+  size_t untilEnd = capacity - tail % capacity;
+  size_t skip = untilEnd < size ? untilEnd : 0;
+
+  // Буфер полон: ждём, пока поток вывода освободит место
+  while (tail + skip + size - ring->cachedHead > capacity) {
+    ring->cachedHead = ring->head.load(std::memory_order_acquire);
+    if (tail + skip + size - ring->cachedHead > capacity) {
+      std::this_thread::yield();
+    }
+  }
+
+  if (skip >= sizeof(Record)) {
+    reinterpret_cast<Record*>(ring->at(tail))->length = WRAP;
+  }
+  tail += skip;
+  auto* record = reinterpret_cast<Record*>(ring->at(tail));
+  record->seq = nextSeq_.fetch_add(1, std::memory_order_relaxed);
+  record->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - startTime_)
+                            .count();
+  record->length = (uint32_t)length;
+  std::memcpy(record + 1, message.data(), length);
+
+  ring->tail.store(tail + size, std::memory_order_release);
+}
+
+// Буфер выделяется при первой записи потока в этот журнал и добавляется в
+// список без блокировок; поток вывода обходит этот список
+AsyncLogger::Ring* AsyncLogger::localRing() {
+  if (localOwner_ == id_) {
+    return localRing_;
+  }
+  auto* ring = new Ring(ringCapacity_);
+  ring->next = rings_.load(std::memory_order_relaxed);
+  while (!rings_.compare_exchange_weak(ring->next, ring,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+  }
+  localRing_ = ring;
+  localOwner_ = id_;
+  return ring;
+}
+
+void AsyncLogger::drainLoop() {
+  while (running_.load(std::memory_order_acquire)) {
+    if (!drainOnce()) {
+      std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+  }
+  // Финальный проход: всё, что успели записать до stop()
+  while (drainOnce()) {
+  }
+}
+
+// Забирает все опубликованные записи, сортирует их по номеру и выводит одной
+// пачкой. Возвращает false, если выводить было нечего.
+bool AsyncLogger::drainOnce() {
+  struct Span {
+    Ring* ring;
+    uint64_t tail;
+  };
+  std::vector<Span> spans;
+  std::vector<const Record*> batch;
+
+  for (Ring* ring = rings_.load(std::memory_order_acquire); ring != nullptr;
+       ring = ring->next) {
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    size_t capacity = ring->capacity();
+    for (uint64_t offset = head; offset < tail;) {
+      size_t untilEnd = capacity - offset % capacity;
+      const auto* record = reinterpret_cast<const Record*>(ring->at(offset));
+      if (untilEnd < sizeof(Record) || record->length == WRAP) {
+        offset += untilEnd;
+        continue;
+      }
+      batch.push_back(record);
+      offset += recordSize(record->length);
+    }
+    if (tail != head) {
+      spans.push_back({ring, tail});
+    }
+  }
+  if (batch.empty()) {
+    return false;
+  }
+
+  std::sort(batch.begin(), batch.end(),
+            [](const Record* a, const Record* b) { return a->seq < b->seq; });
+
+  std::string buffer;
+  buffer.reserve(batch.size() * 128);
+  for (const Record* record : batch) {
+    if (timestamps_) {
+      char prefix[64];
+      int n = std::snprintf(prefix, sizeof(prefix), "[%llu +%.6f] ",
+                            (unsigned long long)record->seq,
+                            (double)record->timestampNs / 1e9);
+      buffer.append(prefix, n);
+    }
+    buffer.append(record->text(), record->length);
+    buffer.push_back('\n');
+  }
+
+  // Текст скопирован, место в буферах можно отдать писателям
+  for (const Span& span : spans) {
+    span.ring->head.store(span.tail, std::memory_order_release);
+  }
+
+  writeAll(STDOUT_FILENO, buffer.data(), buffer.size());
+  if (fileFd_ >= 0) {
+    writeAll(fileFd_, buffer.data(), buffer.size());
+  }
+  return true;
+}
+
+void AsyncLogger::writeAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += written;
+    size -= (size_t)written;
+  }
+}
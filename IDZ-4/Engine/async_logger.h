@@ -0,0 +1,101 @@
+#ifndef ENGINE_ASYNC_LOGGER_H
+#define ENGINE_ASYNC_LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Асинхронный журнал без блокировок.
+// Каждый пишущий поток получает собственный кольцевой буфер байтов (один
+// писатель, один читатель) с записями переменной длины, а отдельный поток
+// вывода собирает записи из всех буферов,
+// упорядочивает их по номеру и отправляет пачку одним вызовом write(2) в
+// stdout и в файл. Поток, который пишет в журнал, не берёт мьютекс и не делает
+// системных вызовов, пока его буфер не переполнен.
+class AsyncLogger {
+ public:
+  // Максимальная длина сообщения в байтах, более длинные обрезаются
+  static constexpr size_t MAX_MESSAGE = 236;
+  // Ёмкость буфера одного потока по умолчанию, байт: около 50 обычных
+  // строк философа. Поток вывода опустошает буферы раз в миллисекунду, а
+  // при миллионе потоков буферы по 32 КБ заняли бы десятки гигабайт.
+  static constexpr size_t DEFAULT_RING_CAPACITY = 4096;
+
+  explicit AsyncLogger(size_t ringCapacity = DEFAULT_RING_CAPACITY);
+  ~AsyncLogger();
+
+  AsyncLogger(const AsyncLogger&) = delete;
+  AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+  // Открывает файл для копии журнала. Вызывать до start().
+  bool openFile(const std::string& path);
+  // Печатать ли перед сообщением его номер и время от начала работы
+  void setTimestamps(bool enabled) { timestamps_ = enabled; }
+
+  void start();
+  // Дописывает все накопленные записи и останавливает поток вывода
+  void stop();
+
+  void log(const std::string& message);
+
+ private:
+  // Заголовок записи; за ним length байт текста, вся запись выровнена по 8
+  struct Record {
+    uint64_t seq;
+    int64_t timestampNs;
+    uint32_t length;  // WRAP - до конца буфера записей нет
+    uint32_t reserved;
+
+    const char* text() const { return (const char*)(this + 1); }
+  };
+  static constexpr uint32_t WRAP = UINT32_MAX;
+
+  // head и tail - байтовые смещения, растущие без переполнения; запись не
+  // разрывается на краю буфера, а остаток до края пропускается
+  struct Ring {
+    explicit Ring(size_t capacity) : words(capacity / 8) {}
+
+    size_t capacity() const { return words.size() * 8; }
+    char* at(uint64_t offset) {
+      return (char*)words.data() + offset % capacity();
+    }
+
+    alignas(64) std::atomic<uint64_t> head{0};  // двигает поток вывода
+    alignas(64) std::atomic<uint64_t> tail{0};  // двигает поток-владелец
+    uint64_t cachedHead = 0;  // последний виденный владельцем head
+    std::vector<uint64_t> words;
+    Ring* next = nullptr;
+  };
+
+  // Байт, которые займёт запись с текстом length
+  static size_t recordSize(size_t length) {
+    return sizeof(Record) + (length + 7) / 8 * 8;
+  }
+
+  Ring* localRing();
+  void drainLoop();
+  bool drainOnce();
+  void writeAll(int fd, const char* data, size_t size);
+
+  const uint64_t id_;  // отличает журнал в кэше потока
+  size_t ringCapacity_;
+  bool timestamps_ = false;
+  int fileFd_ = -1;
+  std::chrono::steady_clock::time_point startTime_;
+
+  alignas(64) std::atomic<uint64_t> nextSeq_{0};
+  alignas(64) std::atomic<Ring*> rings_{nullptr};
+  std::atomic<bool> running_{false};
+  std::thread drainThread_;
+
+  // Буфер потока и id_ журнала, к которому он привязан. Адрес журнала не
+  // годится: новый журнал может занять адрес удалённого.
+  static thread_local Ring* localRing_;
+  static thread_local uint64_t localOwner_;
+};
+
+#endif  // ENGINE_ASYNC_LOGGER_H
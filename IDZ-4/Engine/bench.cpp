@@ -0,0 +1,226 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "config.h"
+#include "fork_arbiter.h"
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  std::istringstream in(list);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+void printBenchUsage(const char* programName) {
+  std::cerr
+      << "Использование: " << programName << " [флаги]\n"
+      << "  --strategies S,...   стратегии (по умолчанию все)\n"
+      << "  --philosophers N,... число философов и потоков (5,16,64)\n"
+      << "  --dists D,...        распределения времени фаз\n"
+      << "                       (uniform,exponential,pareto)\n"
+      << "  --think MIN MAX      время размышления (1ms 10ms)\n"
+      << "  --eat MIN MAX        время приема пищи (1ms 10ms)\n"
+      << "  --duration T         длительность прогона (2s)\n"
+      << "                       (длительности - с единицами ns, us, ms, s)\n"
+      << "  --seed N             зерно генераторов (1)\n"
+      << "  --tasks              философы - задачи на пуле рабочих потоков\n"
+      << "  --coroutines         философы - корутины на пуле рабочих потоков\n"
+      << "  --pin P,...          привязка потоков философов (none)\n"
+      << "                       (none,compact,scatter,neighbours;\n"
+      << "                       только для потоков философов)\n"
+      << "  --max-bypass K       предел обходов для стратегии aging ("
+      << DEFAULT_MAX_BYPASS << ")\n"
+      << "  --workers N          число рабочих потоков для --tasks и\n"
+      << "                       --coroutines\n"
+      << "                       (по потоку на процессор)\n"
+      << "  --csv FILE           записать результаты в CSV\n"
+      << "  --json FILE          записать результаты в JSON\n";
+}
+
+}  // namespace
+
+// Прогоняет каждую стратегию на сетке параметров и печатает пропускную
+// способность, задержку получения вилок, справедливость и загрузку CPU
+int main(int argc, char* argv[]) {
+  std::vector<std::string> strategies;
+  std::vector<std::string> sizes = {"5", "16", "64"};
+  std::vector<std::string> dists = {"uniform", "exponential", "pareto"};
+  std::vector<std::string> pins = {"none"};
+  Config base;
+  base.minThink = std::chrono::milliseconds(1);
+  base.maxThink = std::chrono::milliseconds(10);
+  base.minEat = std::chrono::milliseconds(1);
+  base.maxEat = std::chrono::milliseconds(10);
+  base.simulationTime = std::chrono::seconds(2);
+  base.seed = 1;
+  bool durationsOk = true;
+  std::string csvPath;
+  std::string jsonPath;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    bool hasPair = i + 2 < argc;
+    if (arg == "--strategies" && hasValue) {
+      strategies = splitList(argv[++i]);
+    } else if (arg == "--philosophers" && hasValue) {
+      sizes = splitList(argv[++i]);
+    } else if (arg == "--dists" && hasValue) {
+      dists = splitList(argv[++i]);
+    } else if (arg == "--pin" && hasValue) {
+      pins = splitList(argv[++i]);
+    } else if (arg == "--think" && hasPair) {
+      durationsOk &= parseDuration(argv[++i], base.minThink);
+      durationsOk &= parseDuration(argv[++i], base.maxThink);
+    } else if (arg == "--eat" && hasPair) {
+      durationsOk &= parseDuration(argv[++i], base.minEat);
+      durationsOk &= parseDuration(argv[++i], base.maxEat);
+    } else if (arg == "--duration" && hasValue) {
+      durationsOk &= parseDuration(argv[++i], base.simulationTime);
+    } else if (arg == "--seed" && hasValue) {
+      base.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--tasks") {
+      base.executor = Executor::Tasks;
+    } else if (arg == "--coroutines") {
+      base.executor = Executor::Coroutines;
+    } else if (arg == "--workers" && hasValue) {
+      if (base.executor == Executor::Threads) {
+        base.executor = Executor::Tasks;
+      }
+      base.workers = std::atoi(argv[++i]);
+    } else if (arg == "--max-bypass" && hasValue) {
+      base.maxBypass = std::atoi(argv[++i]);
+    } else if (arg == "--csv" && hasValue) {
+      csvPath = argv[++i];
+    } else if (arg == "--json" && hasValue) {
+      jsonPath = argv[++i];
+    } else {
+      printBenchUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (!durationsOk || base.minThink < MIN_PHASE_TIME ||
+      base.minThink > base.maxThink || base.minEat < MIN_PHASE_TIME ||
+      base.minEat > base.maxEat || base.simulationTime <= Duration::zero() ||
+      base.workers < 0 || base.maxBypass < 0) {
+    std::cerr << "Неправильные значения параметров\n";
+    return 1;
+  }
+  // Без этой проверки строки с --tasks/--coroutines называли бы привязку,
+  // которой не было
+  for (const auto& pin : pins) {
+    if (pin != "none" && base.executor != Executor::Threads) {
+      std::cerr << "--pin " << pin
+                << " привязывает потоки философов и не сочетается с "
+                   "--tasks и --coroutines\n";
+      return 1;
+    }
+  }
+
+  // По умолчанию - все стратегии, а на планировщике M:N - те, что описывают
+  // протокол захвата вилок
+  if (strategies.empty()) {
+    for (const auto& name : arbiterNames()) {
+      VirtualProtocol protocol{};
+      if (base.executor == Executor::Threads ||
+          makeArbiter(name, MIN_PHILOSOPHERS)->virtualProtocol(protocol)) {
+        strategies.push_back(name);
+      }
+    }
+  }
+
+  std::vector<BenchResult> results;
+  bool boundHeld = true;
+  std::printf(
+      "%-16s %7s %-12s %-10s %10s %10s %10s %10s %8s %6s %9s %7s %9s\n",
+      "strategy", "N", "dist", "pin", "meals/s", "p50 us", "p99 us",
+      "p999 us", "fairness", "cpu", "csw/s", "nb/wait", "miss/meal");
+  for (const auto& strategy : strategies) {
+    for (const auto& size : sizes) {
+      for (const auto& dist : dists) {
+        for (const auto& pin : pins) {
+          Config config = base;
+          config.strategy = strategy;
+          config.numPhilosophers = std::atoi(size.c_str());
+          if (!parseDistribution(dist, config.thinkDistribution) ||
+              !parsePinPolicy(pin, config.pin) ||
+              config.numPhilosophers < MIN_PHILOSOPHERS ||
+              config.numPhilosophers > MAX_PHILOSOPHERS) {
+            printBenchUsage(argv[0]);
+            return 1;
+          }
+          config.eatDistribution = config.thinkDistribution;
+
+          BenchResult result;
+          if (!runBenchmark(config, result)) {
+            std::cerr << (config.executor != Executor::Threads
+                              ? "Стратегия неизвестна или не поддерживает "
+                                "планировщик M:N: "
+                              : "Неизвестная стратегия: ")
+                      << strategy << "\n";
+            return 1;
+          }
+          // Промахи кэша на один обед; "-" - счётчик недоступен
+          char misses[32] = "-";
+          if (result.cacheMisses >= 0 && result.meals > 0) {
+            std::snprintf(misses, sizeof(misses), "%.0f",
+                          (double)result.cacheMisses / result.meals);
+          }
+          std::printf(
+              "%-16s %7d %-12s %-10s %10.1f %10.1f %10.1f %10.1f %8.4f "
+              "%5.1f%% %9.0f %7ld %9s\n",
+              strategy.c_str(), config.numPhilosophers, dist.c_str(),
+              pin.c_str(), result.mealsPerSecond, result.waitP50,
+              result.waitP99, result.waitP999, result.fairness,
+              result.cpuUtilization * 100, result.switchesPerSecond,
+              result.maxNeighbourMeals, misses);
+          std::fflush(stdout);
+          // aging обещает не больше maxBypass обходов младшими соседями и по
+          // одному обеду каждого соседа с более ранней заявкой. Граница
+          // проверяется по учёту арбитра: счётчики философов начинают
+          // отсчёт с события Hungry, ещё до того, как заявка дошла до
+          // арбитра.
+          if (strategy == "aging" &&
+              result.arbiterNeighbourMeals > config.maxBypass + 2) {
+            std::cerr << "Нарушена граница aging: соседи поели "
+                      << result.arbiterNeighbourMeals
+                      << " раз за одно ожидание, предел "
+                      << config.maxBypass + 2 << "\n";
+            boundHeld = false;
+          }
+          results.push_back(result);
+        }
+      }
+    }
+  }
+
+  if (!csvPath.empty()) {
+    std::ofstream csv(csvPath);
+    writeCsv(csv, results);
+    if (!csv) {
+      std::cerr << "Ошибка записи " << csvPath << "\n";
+      return 1;
+    }
+  }
+  if (!jsonPath.empty()) {
+    std::ofstream json(jsonPath);
+    writeJson(json, results);
+    if (!json) {
+      std::cerr << "Ошибка записи " << jsonPath << "\n";
+      return 1;
+    }
+  }
+  return boundHeld ? 0 : 1;
+}
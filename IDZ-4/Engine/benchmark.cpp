@@ -0,0 +1,168 @@
+#include "benchmark.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "latency_histogram.h"
+#include "perf_counter.h"
+#include "simulation.h"
+
+namespace {
+
+double cpuTime() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+long voluntarySwitches() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_nvcsw;
+}
+
+double toMicros(Duration duration) { return duration.count() / 1000.0; }
+
+}  // namespace
+
+double jainFairness(const std::vector<long>& values) {
+  double sum = 0;
+  double squares = 0;
+  for (long x : values) {
+    sum += x;
+    squares += (double)x * x;
+  }
+  if (squares == 0) return 0;
+  return sum * sum / (values.size() * squares);
+}
+
+bool runBenchmark(const Config& config, BenchResult& result) {
+  std::unique_ptr<ForkArbiter> arbiter =
+      makeArbiter(config.strategy, config.numPhilosophers,
+                  config.maxBypass);
+  VirtualProtocol protocol{};
+  if (!arbiter || (config.executor != Executor::Threads &&
+                   !arbiter->virtualProtocol(protocol))) {
+    return false;
+  }
+
+  Table table;
+  table.config = &config;
+  table.arbiter = arbiter.get();
+  LatencyRecorder latency;
+  table.latency = &latency;
+
+  std::vector<Philosopher> philosophers(config.numPhilosophers);
+  for (int i = 0; i < config.numPhilosophers; i++) {
+    philosophers[i].id = i;
+    philosophers[i].random = RandomSource(config.seed, i);
+  }
+
+  table.philosophers = &philosophers;
+
+  double cpuStart = cpuTime();
+  long switchesStart = voluntarySwitches();
+  CacheMissCounter cacheMisses;
+  table.start = std::chrono::steady_clock::now();
+  launchPhilosophers(table, philosophers, launchPthreads);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - table.start;
+  long long misses = cacheMisses.read();
+
+  result = BenchResult();
+  result.config = config;
+  result.seconds = elapsed.count();
+  result.cpuSeconds = cpuTime() - cpuStart;
+  result.cacheMisses = misses;
+  result.switchesPerSecond =
+      (voluntarySwitches() - switchesStart) / result.seconds;
+  long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  if (config.executor == Executor::Threads) {
+    result.threads = config.numPhilosophers;
+  } else if (config.workers > 0) {
+    result.threads = config.workers;
+  } else {
+    result.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+  }
+  result.cpuUtilization =
+      result.cpuSeconds / (result.seconds * std::max(1L, processors));
+
+  std::vector<long> meals;
+  meals.reserve(philosophers.size());
+  for (const auto& philosopher : philosophers) {
+    meals.push_back(philosopher.stats.meals.load());
+    result.meals += philosopher.stats.meals.load();
+    result.maxNeighbourMeals = std::max(
+        result.maxNeighbourMeals, philosopher.stats.maxNeighbourMeals.load());
+  }
+  result.arbiterNeighbourMeals = arbiter->maxNeighbourMeals();
+  result.mealsPerSecond = result.meals / result.seconds;
+  result.fairness = jainFairness(meals);
+  LatencyHistogram waits = latency.merged();
+  result.waitP50 = waits.percentile(0.5) / 1000.0;
+  result.waitP99 = waits.percentile(0.99) / 1000.0;
+  result.waitP999 = waits.percentile(0.999) / 1000.0;
+  return true;
+}
+
+void writeCsv(std::ostream& out, const std::vector<BenchResult>& results) {
+  out << "strategy,executor,pin,philosophers,threads,think_dist,eat_dist,"
+         "min_think_us,max_think_us,min_eat_us,max_eat_us,seconds,meals,"
+         "meals_per_sec,wait_p50_us,wait_p99_us,wait_p999_us,fairness,"
+         "cpu_seconds,cpu_utilization,switches_per_sec,max_neighbour_meals,"
+         "arbiter_neighbour_meals,cache_misses\n";
+  for (const auto& r : results) {
+    const Config& c = r.config;
+    out << c.strategy << "," << executorName(c.executor) << ","
+        << pinPolicyName(c.pin) << "," << c.numPhilosophers << ","
+        << r.threads << ","
+        << distributionName(c.thinkDistribution) << ","
+        << distributionName(c.eatDistribution) << ","
+        << toMicros(c.minThink) << "," << toMicros(c.maxThink) << ","
+        << toMicros(c.minEat) << "," << toMicros(c.maxEat) << ","
+        << r.seconds << "," << r.meals << ","
+        << r.mealsPerSecond << "," << r.waitP50 << "," << r.waitP99 << ","
+        << r.waitP999 << "," << r.fairness << "," << r.cpuSeconds << ","
+        << r.cpuUtilization << "," << r.switchesPerSecond << ","
+        << r.maxNeighbourMeals << "," << r.arbiterNeighbourMeals << ","
+        << r.cacheMisses << "\n";
+  }
+}
+
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results) {
+  out << "[\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult& r = results[i];
+    const Config& c = r.config;
+    out << "  {\"strategy\": \"" << c.strategy << "\""
+        << ", \"executor\": \"" << executorName(c.executor) << "\""
+        << ", \"pin\": \"" << pinPolicyName(c.pin) << "\""
+        << ", \"philosophers\": " << c.numPhilosophers
+        << ", \"threads\": " << r.threads << ", \"think_dist\": \""
+        << distributionName(c.thinkDistribution) << "\", \"eat_dist\": \""
+        << distributionName(c.eatDistribution) << "\""
+        << ", \"min_think_us\": " << toMicros(c.minThink)
+        << ", \"max_think_us\": " << toMicros(c.maxThink)
+        << ", \"min_eat_us\": " << toMicros(c.minEat)
+        << ", \"max_eat_us\": " << toMicros(c.maxEat)
+        << ", \"seconds\": " << r.seconds << ", \"meals\": " << r.meals
+        << ", \"meals_per_sec\": " << r.mealsPerSecond
+        << ", \"wait_p50_us\": " << r.waitP50
+        << ", \"wait_p99_us\": " << r.waitP99
+        << ", \"wait_p999_us\": " << r.waitP999
+        << ", \"fairness\": " << r.fairness
+        << ", \"cpu_seconds\": " << r.cpuSeconds
+        << ", \"cpu_utilization\": " << r.cpuUtilization
+        << ", \"switches_per_sec\": " << r.switchesPerSecond
+        << ", \"max_neighbour_meals\": " << r.maxNeighbourMeals
+        << ", \"arbiter_neighbour_meals\": " << r.arbiterNeighbourMeals
+        << ", \"cache_misses\": " << r.cacheMisses << "}"
+        << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
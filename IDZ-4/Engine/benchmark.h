@@ -0,0 +1,48 @@
+#ifndef ENGINE_BENCHMARK_H
+#define ENGINE_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "config.h"
+
+// Результат одного прогона стратегии под нагрузкой
+struct BenchResult {
+  Config config;
+  int threads = 0;             // потоков философов или рабочих потоков
+  double seconds = 0;          // фактическое время прогона
+  long meals = 0;              // всего приемов пищи
+  double mealsPerSecond = 0;
+  // Перцентили времени от голода до начала еды, мкс
+  double waitP50 = 0;
+  double waitP99 = 0;
+  double waitP999 = 0;
+  double fairness = 0;         // индекс справедливости Джайна по приемам пищи
+  double cpuSeconds = 0;       // user + system время процесса
+  double cpuUtilization = 0;   // доля всех процессоров, 0..1
+  // Добровольные переключения контекста (засыпания потоков) в секунду
+  double switchesPerSecond = 0;
+  // Больше всего обедов соседей за одно ожидание вилок: от события Hungry
+  // по счётчикам философов и по учёту стратегии (-1 - не ведёт)
+  long maxNeighbourMeals = 0;
+  long arbiterNeighbourMeals = -1;
+  // Промахи кэша последнего уровня в пространстве пользователя за прогон;
+  // -1 - счётчик недоступен (нет PMU или запрещён perf_event_paranoid)
+  long long cacheMisses = -1;
+};
+
+// Проводит симуляцию config в реальном времени без журнала событий.
+// Возвращает false, если стратегия неизвестна или (на планировщике M:N) не
+// описывает протокол захвата вилок.
+bool runBenchmark(const Config& config, BenchResult& result);
+
+// Индекс Джайна (sum x)^2 / (n * sum x^2): 1 - все поровну, 1/n - всё
+// досталось одному
+double jainFairness(const std::vector<long>& values);
+
+void writeCsv(std::ostream& out, const std::vector<BenchResult>& results);
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results);
+
+#endif  // ENGINE_BENCHMARK_H
@@ -0,0 +1,39 @@
+#include "cancellation.h"
+
+#include "futex.h"
+
+void CancellationToken::cancel() {
+  std::vector<std::function<void()>> wakers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_.exchange(1) != 0) return;
+    wakers.swap(wakers_);
+  }
+  futexWakeAll(&state_);
+  for (const auto& wake : wakers) {
+    wake();
+  }
+}
+
+void CancellationToken::subscribe(std::function<void()> wake) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (active()) {
+      wakers_.push_back(std::move(wake));
+      return;
+    }
+  }
+  wake();
+}
+
+bool CancellationToken::waitUntil(Clock::time_point when) {
+  while (active()) {
+    auto left = when - Clock::now();
+    if (left <= Clock::duration::zero()) break;
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(left);
+    timespec timeout{(time_t)(nanos.count() / 1000000000),
+                     (long)(nanos.count() % 1000000000)};
+    futexWait(&state_, 0, &timeout);
+  }
+  return active();
+}
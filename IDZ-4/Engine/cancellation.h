@@ -0,0 +1,43 @@
+#ifndef ENGINE_CANCELLATION_H
+#define ENGINE_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Токен отмены: флаг работы программы, отмена которого прерывает все
+// блокирующие ожидания. Флаг - futex-слово, поэтому на самом токене можно
+// спать до срока и проснуться сразу при отмене. Остальные ожидания (вилки,
+// условные переменные, служба таймеров) подписывают на токен функции
+// пробуждения, и cancel() вызывает их один раз.
+class CancellationToken {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  CancellationToken() = default;
+  CancellationToken(const CancellationToken&) = delete;
+  CancellationToken& operator=(const CancellationToken&) = delete;
+
+  // true, пока отмена не запрошена
+  bool active() const { return state_.load(std::memory_order_acquire) == 0; }
+  explicit operator bool() const { return active(); }
+
+  // Сбрасывает флаг и будит всех ожидающих. Повторные вызовы ничего не
+  // делают.
+  void cancel();
+  // Функция вызывается при отмене; если отмена уже была - сразу
+  void subscribe(std::function<void()> wake);
+
+  // Спит до момента when или до отмены. Возвращает active().
+  bool waitUntil(Clock::time_point when);
+
+ private:
+  std::atomic<uint32_t> state_{0};  // 1 - отменён
+  std::mutex mutex_;
+  std::vector<std::function<void()>> wakers_;
+};
+
+#endif  // ENGINE_CANCELLATION_H
@@ -0,0 +1,138 @@
+#include "chandy_misra_arbiter.h"
+
+#include <algorithm>
+
+ChandyMisraArbiter::ChandyMisraArbiter(int numPhilosophers)
+    : ForkArbiter(numPhilosophers),
+      forks_(numPhilosophers),
+      mailboxes_(numPhilosophers) {
+  // Каждая вилка вначале грязная и лежит у соседа с меньшим номером: граф
+  // приоритетов ацикличен, поэтому тупик невозможен
+  for (int fork = 0; fork < numPhilosophers_; ++fork) {
+    int left = (fork + numPhilosophers_ - 1) % numPhilosophers_;
+    forks_[fork].owner = std::min(fork, left);
+  }
+}
+
+int ChandyMisraArbiter::neighbour(int fork, int philosopher) const {
+  // Вилка fork - левая для философа fork и правая для философа fork - 1
+  return philosopher == fork ? (fork + numPhilosophers_ - 1) % numPhilosophers_
+                             : fork;
+}
+
+bool ChandyMisraArbiter::claim(int fork, int philosopher) {
+  Fork& f = forks_[fork];
+  std::lock_guard<std::mutex> lock(f.mutex);
+  if (f.owner == philosopher) {
+    return true;
+  }
+  // Грязную вилку сосед обязан отдать, если он не ест
+  if (f.dirty && !f.inUse) {
+    f.owner = philosopher;
+    f.dirty = false;
+    f.requested = false;
+    return true;
+  }
+  f.requested = true;
+  return false;
+}
+
+void ChandyMisraArbiter::handOver(int fork, int philosopher) {
+  Fork& f = forks_[fork];
+  int receiver = neighbour(fork, philosopher);
+  {
+    std::lock_guard<std::mutex> lock(f.mutex);
+    // Отменённый философ мог так и не получить вилку: чужую вилку, которой,
+    // может быть, ест сосед, трогать нельзя
+    if (f.owner != philosopher) {
+      return;
+    }
+    f.inUse = false;
+    f.dirty = true;
+    if (!f.requested) {
+      return;
+    }
+    f.owner = receiver;
+    f.dirty = false;
+    f.requested = false;
+  }
+  // Захват мьютекса получателя не даёт уведомлению проскочить между его
+  // проверкой вилок и засыпанием
+  Mailbox& mailbox = mailboxes_[receiver];
+  { std::lock_guard<std::mutex> lock(mailbox.mutex); }
+  mailbox.forkArrived.notify_one();
+}
+
+bool ChandyMisraArbiter::startEating(int philosopher) {
+  int left = leftFork(philosopher);
+  int right = rightFork(philosopher);
+  // std::lock берёт оба мьютекса без взаимной блокировки с соседями
+  std::lock(forks_[left].mutex, forks_[right].mutex);
+  std::lock_guard<std::mutex> leftLock(forks_[left].mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> rightLock(forks_[right].mutex,
+                                        std::adopt_lock);
+  if (forks_[left].owner != philosopher ||
+      forks_[right].owner != philosopher) {
+    return false;
+  }
+  forks_[left].inUse = forks_[right].inUse = true;
+  forks_[left].dirty = forks_[right].dirty = true;
+  return true;
+}
+
+bool ChandyMisraArbiter::owns(int fork, int philosopher) {
+  std::lock_guard<std::mutex> lock(forks_[fork].mutex);
+  return forks_[fork].owner == philosopher;
+}
+
+bool ChandyMisraArbiter::acquire(int philosopher,
+                                 const CancellationToken& running,
+                                 const EventReporter& report) {
+  int left = leftFork(philosopher);
+  int right = rightFork(philosopher);
+  report(EventType::TakeFork, left);
+  report(EventType::TakeFork, right);
+
+  Mailbox& mailbox = mailboxes_[philosopher];
+  while (running) {
+    // Запросы отправляются за обеими вилками сразу
+    bool hasLeft = claim(left, philosopher);
+    bool hasRight = claim(right, philosopher);
+    if (!hasLeft) report(EventType::ForkBusy, left);
+    if (!hasRight) report(EventType::ForkBusy, right);
+    if (hasLeft && hasRight) {
+      if (startEating(philosopher)) {
+        return true;
+      }
+      // Грязную вилку успел забрать сосед - запрашиваем её снова
+      continue;
+    }
+
+    // Ждём, пока сосед передаст недостающую вилку. Пока мы ждём, грязную
+    // вилку у нас может забрать другой сосед - тогда после пробуждения
+    // запросим её снова.
+    std::unique_lock<std::mutex> lock(mailbox.mutex);
+    mailbox.forkArrived.wait(lock, [&] {
+      return (!hasLeft && owns(left, philosopher)) ||
+             (!hasRight && owns(right, philosopher)) || !running;
+    });
+  }
+
+  // Программа завершается: отдаём запрошенные вилки, иначе соседи будут
+  // ждать чистую вилку, которой мы уже не воспользуемся
+  handOver(leftFork(philosopher), philosopher);
+  handOver(rightFork(philosopher), philosopher);
+  return false;
+}
+
+void ChandyMisraArbiter::cancel() {
+  for (auto& mailbox : mailboxes_) {
+    { std::lock_guard<std::mutex> lock(mailbox.mutex); }
+    mailbox.forkArrived.notify_all();
+  }
+}
+
+void ChandyMisraArbiter::release(int philosopher) {
+  handOver(rightFork(philosopher), philosopher);
+  handOver(leftFork(philosopher), philosopher);
+}
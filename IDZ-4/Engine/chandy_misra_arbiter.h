@@ -0,0 +1,58 @@
+#ifndef ENGINE_CHANDY_MISRA_ARBITER_H
+#define ENGINE_CHANDY_MISRA_ARBITER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "fork_arbiter.h"
+
+// Решение Чанди-Мисры: вилка - маркер, который передаётся между двумя
+// соседями. Вилка бывает чистой и грязной: после еды обе вилки философа
+// грязные, и по запросу соседа грязная вилка отдаётся (очищенной), а чистая
+// остаётся у голодного владельца до конца его еды. Запрос, который нельзя
+// выполнить сразу, запоминается в вилке и выполняется при release().
+// Глобальной блокировки нет: каждая вилка защищена своим мьютексом, а
+// философ ждёт на своей условной переменной, так что конкурируют только
+// соседи.
+class ChandyMisraArbiter : public ForkArbiter {
+ public:
+  explicit ChandyMisraArbiter(int numPhilosophers);
+
+  const char* name() const override { return "chandy-misra"; }
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override;
+  void release(int philosopher) override;
+  void cancel() override;
+
+ private:
+  struct Fork {
+    std::mutex mutex;
+    int owner = 0;           // у кого сейчас вилка
+    bool dirty = true;       // владелец уже ел этой вилкой
+    bool inUse = false;      // владелец ест
+    bool requested = false;  // сосед прислал запрос на вилку
+  };
+
+  // Почтовый ящик философа: сюда его будят при передаче вилки
+  struct Mailbox {
+    std::mutex mutex;
+    std::condition_variable forkArrived;
+  };
+
+  // Второй философ, пользующийся вилкой fork
+  int neighbour(int fork, int philosopher) const;
+  // Вилка у философа или забрана у соседа; иначе отправляет запрос
+  bool claim(int fork, int philosopher);
+  // Кладёт вилку философа грязной и, если сосед просил её, передаёт ему
+  // чистой. Вилки, которыми философ не владеет, не трогает.
+  void handOver(int fork, int philosopher);
+  // Берёт обе вилки для еды, если они всё ещё у философа
+  bool startEating(int philosopher);
+  bool owns(int fork, int philosopher);
+
+  std::vector<Fork> forks_;
+  std::vector<Mailbox> mailboxes_;
+};
+
+#endif  // ENGINE_CHANDY_MISRA_ARBITER_H
@@ -0,0 +1,159 @@
+#include "chrome_trace.h"
+
+#include <algorithm>
+
+namespace {
+
+// Процессы в просмотрщике: дорожки философов и дорожки вилок
+const int PHILOSOPHERS_PID = 1;
+const int FORKS_PID = 2;
+
+// Интервалы на дорожке философа
+const char* const THINKING = "думает";
+const char* const HUNGRY = "голоден";
+const char* const EATING = "ест";
+
+// Буфер выводится в файл, когда набирается столько байт
+const size_t FLUSH_SIZE = 1 << 20;
+
+}  // namespace
+
+ChromeTraceExporter::ChromeTraceExporter(std::FILE* out) : out_(out) {
+  buffer_ = "{\"traceEvents\":[\n";
+  nameProcess(PHILOSOPHERS_PID, "Философы");
+  nameProcess(FORKS_PID, "Вилки: только еда");
+}
+
+ChromeTraceExporter::PhilosopherState& ChromeTraceExporter::state(
+    int philosopher) {
+  if ((size_t)philosopher >= philosophers_.size()) {
+    philosophers_.resize(philosopher + 1);
+  }
+  PhilosopherState& s = philosophers_[philosopher];
+  if (!s.named) {
+    s.named = true;
+    nameTrack(PHILOSOPHERS_PID, philosopher,
+              "Философ " + std::to_string(philosopher));
+  }
+  return s;
+}
+
+void ChromeTraceExporter::add(const Event& event) {
+  int p = event.philosopher;
+  PhilosopherState& s = state(p);
+  last_ = std::max(last_, event.time);
+  switch (event.type) {
+    case EventType::Think:
+      beginPhase(p, THINKING, event.time);
+      break;
+    case EventType::Hungry:
+      beginPhase(p, HUNGRY, event.time);
+      s.requested = 0;
+      s.forks[0] = s.forks[1] = -1;
+      break;
+    case EventType::WaitPermission:
+      instant(p, "ждет разрешения", -1, event.time);
+      break;
+    case EventType::TakeFork:
+      instant(p, "тянется к вилке", event.fork, event.time);
+      if (s.requested < 2) {
+        s.forks[s.requested++] = event.fork;
+      }
+      break;
+    case EventType::Eat:
+      beginPhase(p, EATING, event.time);
+      break;
+    case EventType::PutDown:
+      endPhase(p, event.time);
+      break;
+    case EventType::ForkBusy:
+      break;
+  }
+}
+
+void ChromeTraceExporter::beginPhase(int philosopher, const char* phase,
+                                     int64_t time) {
+  endPhase(philosopher, time);
+  PhilosopherState& s = philosophers_[philosopher];
+  s.phase = phase;
+  s.since = time;
+}
+
+void ChromeTraceExporter::endPhase(int philosopher, int64_t time) {
+  PhilosopherState& s = philosophers_[philosopher];
+  if (!s.phase) return;
+  complete(PHILOSOPHERS_PID, philosopher, s.phase, s.since, time - s.since);
+  // На дорожках вилок только еда, от Eat до PutDown. Событие о том, что вилка
+  // взята, арбитры не пишут, поэтому время, когда философ держит первую
+  // вилку и ждёт вторую, здесь не видно - его показывают отметки на дорожке
+  // философа
+  if (s.phase == EATING) {
+    for (int fork : s.forks) {
+      if (fork < 0) continue;
+      if ((size_t)fork >= namedForks_.size()) {
+        namedForks_.resize(fork + 1);
+      }
+      if (!namedForks_[fork]) {
+        namedForks_[fork] = true;
+        nameTrack(FORKS_PID, fork, "Вилка " + std::to_string(fork));
+      }
+      complete(FORKS_PID, fork, "Философ " + std::to_string(philosopher),
+               s.since, time - s.since);
+    }
+  }
+  s.phase = nullptr;
+}
+
+void ChromeTraceExporter::complete(int pid, int tid, const std::string& name,
+                                   int64_t time, int64_t duration) {
+  emit("{\"name\":\"" + name + "\",\"ph\":\"X\",\"pid\":" +
+       std::to_string(pid) + ",\"tid\":" + std::to_string(tid) +
+       ",\"ts\":" + std::to_string(time) +
+       ",\"dur\":" + std::to_string(duration) + "}");
+}
+
+void ChromeTraceExporter::instant(int tid, const char* name, int fork,
+                                  int64_t time) {
+  std::string args =
+      fork < 0 ? "" : ",\"args\":{\"fork\":" + std::to_string(fork) + "}";
+  emit("{\"name\":\"" + std::string(name) +
+       "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":" +
+       std::to_string(PHILOSOPHERS_PID) + ",\"tid\":" + std::to_string(tid) +
+       ",\"ts\":" + std::to_string(time) + args + "}");
+}
+
+void ChromeTraceExporter::nameProcess(int pid, const char* name) {
+  emit("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" +
+       std::to_string(pid) + ",\"args\":{\"name\":\"" + name + "\"}}");
+}
+
+// Имя дорожки; sort_index сохраняет порядок номеров в просмотрщике
+void ChromeTraceExporter::nameTrack(int pid, int tid,
+                                    const std::string& name) {
+  std::string ids =
+      ",\"pid\":" + std::to_string(pid) + ",\"tid\":" + std::to_string(tid);
+  emit("{\"name\":\"thread_name\",\"ph\":\"M\"" + ids +
+       ",\"args\":{\"name\":\"" + name + "\"}}");
+  emit("{\"name\":\"thread_sort_index\",\"ph\":\"M\"" + ids +
+       ",\"args\":{\"sort_index\":" + std::to_string(tid) + "}}");
+}
+
+void ChromeTraceExporter::emit(const std::string& json) {
+  if (!first_) buffer_ += ",\n";
+  first_ = false;
+  buffer_ += json;
+  if (buffer_.size() >= FLUSH_SIZE) {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), out_);
+    buffer_.clear();
+  }
+}
+
+bool ChromeTraceExporter::finish() {
+  for (size_t p = 0; p < philosophers_.size(); ++p) {
+    endPhase((int)p, last_);
+  }
+  buffer_ += "\n],\"displayTimeUnit\":\"ms\"}\n";
+  std::fwrite(buffer_.data(), 1, buffer_.size(), out_);
+  buffer_.clear();
+  return std::fflush(out_) == 0 && !std::ferror(out_);
+}
@@ -0,0 +1,54 @@
+#ifndef ENGINE_CHROME_TRACE_H
+#define ENGINE_CHROME_TRACE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "events.h"
+
+// Экспорт событий в JSON формата Chrome trace event, который открывают
+// chrome://tracing и ui.perfetto.dev. У каждого философа своя дорожка с
+// интервалами "думает", "голоден", "ест" и отметками попыток взять вилку, у
+// каждой вилки - дорожка с интервалами, когда за ней ел философ. Удержание
+// одной вилки в ожидании второй на дорожках вилок не показано. JSON пишется
+// по мере поступления событий: в памяти только текущее состояние философов.
+class ChromeTraceExporter {
+ public:
+  explicit ChromeTraceExporter(std::FILE* out);
+
+  // События должны идти по времени, как их выдаёт TraceReader
+  void add(const Event& event);
+  // Закрывает незавершённые интервалы и дописывает JSON
+  bool finish();
+
+ private:
+  struct PhilosopherState {
+    const char* phase = nullptr;  // открытый интервал, nullptr - нет
+    int64_t since = 0;
+    int forks[2] = {-1, -1};  // вилки, за которыми философ тянулся
+    int requested = 0;
+    bool named = false;
+  };
+
+  PhilosopherState& state(int philosopher);
+  void beginPhase(int philosopher, const char* phase, int64_t time);
+  // Закрывает интервал философа; после еды - и интервалы его вилок
+  void endPhase(int philosopher, int64_t time);
+  void complete(int pid, int tid, const std::string& name, int64_t time,
+                int64_t duration);
+  void instant(int tid, const char* name, int fork, int64_t time);
+  void nameProcess(int pid, const char* name);
+  void nameTrack(int pid, int tid, const std::string& name);
+  void emit(const std::string& json);
+
+  std::FILE* out_;
+  std::string buffer_;
+  bool first_ = true;
+  int64_t last_ = 0;
+  std::vector<PhilosopherState> philosophers_;
+  std::vector<bool> namedForks_;
+};
+
+#endif  // ENGINE_CHROME_TRACE_H
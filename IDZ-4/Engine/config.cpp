@@ -0,0 +1,263 @@
+#include "config.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "fork_arbiter.h"
+
+const char* executorName(Executor executor) {
+  switch (executor) {
+    case Executor::Threads:
+      return "threads";
+    case Executor::Tasks:
+      return "tasks";
+    case Executor::Coroutines:
+      return "coroutines";
+  }
+  return "?";
+}
+
+bool parseDuration(const std::string& text, Duration& duration) {
+  const char* begin = text.c_str();
+  char* end = nullptr;
+  double value = std::strtod(begin, &end);
+  if (end == begin || !(value >= 0)) return false;
+
+  std::string suffix = end;
+  double nanos;
+  if (suffix.empty() || suffix == "s") {
+    nanos = value * 1e9;
+  } else if (suffix == "ms") {
+    nanos = value * 1e6;
+  } else if (suffix == "us") {
+    nanos = value * 1e3;
+  } else if (suffix == "ns") {
+    nanos = value;
+  } else {
+    return false;
+  }
+  // Не больше суток: такие фазы и симуляции не имеют смысла
+  if (nanos > 86400e9) return false;
+  duration = Duration((int64_t)std::llround(nanos));
+  return true;
+}
+
+// Функция для проверки корректности параметров
+bool validateConfig(const Config& config, Duration maxPhaseTime) {
+  auto inPhase = [maxPhaseTime](Duration value) {
+    return value >= MIN_PHASE_TIME && value <= maxPhaseTime;
+  };
+  return config.simulationTime >= MIN_SIMULATION_TIME &&
+         config.simulationTime <= MAX_SIMULATION_TIME &&
+         inPhase(config.minThink) && inPhase(config.maxThink) &&
+         config.minThink <= config.maxThink && inPhase(config.minEat) &&
+         inPhase(config.maxEat) && config.minEat <= config.maxEat &&
+         config.numPhilosophers >= MIN_PHILOSOPHERS &&
+         config.numPhilosophers <= MAX_PHILOSOPHERS && config.workers >= 0 &&
+         config.maxBypass >= 0 &&
+         // Привязываются потоки философов, у задач и корутин их нет
+         (config.pin == PinPolicy::None ||
+          config.executor == Executor::Threads);
+}
+
+// Функция для чтения конфигурации из файла
+bool readConfigFromFile(const std::string& filename, Config& config) {
+  std::ifstream config_file(filename);
+  if (!config_file.is_open()) {
+    std::cerr << "Ошибка открытия файла конфигурации\n";
+    return false;
+  }
+  std::string line;
+  while (std::getline(config_file, line)) {
+    std::istringstream iss(line);
+    std::string key;
+    if (std::getline(iss, key, '=')) {
+      std::string value;
+      if (iss >> value) {
+        // Длительности записываются с единицами, как в parseDuration()
+        bool ok = true;
+        if (key == "minThink")
+          ok = parseDuration(value, config.minThink);
+        else if (key == "maxThink")
+          ok = parseDuration(value, config.maxThink);
+        else if (key == "minEat")
+          ok = parseDuration(value, config.minEat);
+        else if (key == "maxEat")
+          ok = parseDuration(value, config.maxEat);
+        else if (key == "simulationTime")
+          ok = parseDuration(value, config.simulationTime);
+        else if (key == "numPhilosophers")
+          config.numPhilosophers = std::atoi(value.c_str());
+        else if (key == "seed")
+          config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        if (!ok) {
+          std::cerr << "Неправильная длительность " << key << "=" << value
+                    << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void printUsage(const char* programName) {
+  std::cerr
+      << "Использование:\n"
+      << "1. С параметрами командной строки:\n"
+      << programName
+      << " -c minThink maxThink minEat maxEat simulationTime"
+         " [numPhilosophers] output_file\n"
+      << "2. С конфигурационным файлом:\n"
+      << programName << " -f config_file output_file\n"
+      << "Длительности - в секундах или с единицами ns, us, ms, s (250us)\n"
+      << "Флаги:\n"
+      << "  --strategy S      стратегия распределения вилок\n"
+      << "  --virtual-time    проиграть симуляцию в виртуальном времени\n"
+      << "  --tasks           философы - задачи на пуле рабочих потоков\n"
+      << "  --coroutines      философы - корутины на пуле рабочих потоков\n"
+      << "  --workers N       число рабочих потоков для --tasks/--coroutines\n"
+      << "  --log-timestamps  печатать номер и время каждого события\n"
+      << "  --max-bypass K    сколько раз младшие соседи могут поесть раньше\n"
+      << "                    ждущего в стратегии aging (" << DEFAULT_MAX_BYPASS
+      << ")\n"
+      << "  --pin P           привязка потоков философов к процессорам\n"
+      << "                    (P: none, compact, scatter, neighbours;\n"
+      << "                    не сочетается с --tasks и --coroutines)\n"
+      << "  --stats FILE      записать счётчики философов в JSON\n"
+      << "  --latency-report  перцентили задержки от голода до еды\n"
+      << "  --trace FILE      писать события в двоичную трассу вместо журнала\n"
+      << "                    (читается программой philo_trace)\n"
+      << "  --seed N          зерно генераторов случайных чисел\n"
+      << "  --think-dist D    распределение времени размышления\n"
+      << "  --eat-dist D      распределение времени приема пищи\n"
+      << "                    (D: uniform, exponential, pareto)\n"
+      << "Стратегии:";
+  for (const auto& name : arbiterNames()) {
+    std::cerr << " " << name;
+  }
+  std::cerr << "\n";
+}
+
+bool parseArguments(int argc, char* argv[], Config& config) {
+  // Отделяем флаги от позиционных параметров
+  config.seed = (uint64_t)time(nullptr);
+  std::vector<char*> positional;
+  for (int i = 0; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--virtual-time") {
+      config.virtualTime = true;
+    } else if (arg == "--tasks") {
+      config.executor = Executor::Tasks;
+    } else if (arg == "--coroutines") {
+      config.executor = Executor::Coroutines;
+    } else if (arg == "--workers" && hasValue) {
+      if (config.executor == Executor::Threads) {
+        config.executor = Executor::Tasks;
+      }
+      config.workers = std::atoi(argv[++i]);
+    } else if (arg == "--stats" && hasValue) {
+      config.statsPath = argv[++i];
+    } else if (arg == "--max-bypass" && hasValue) {
+      config.maxBypass = std::atoi(argv[++i]);
+    } else if (arg == "--pin" && hasValue) {
+      if (!parsePinPolicy(argv[++i], config.pin)) {
+        printUsage(argv[0]);
+        return false;
+      }
+    } else if (arg == "--trace" && hasValue) {
+      config.tracePath = argv[++i];
+    } else if (arg == "--latency-report") {
+      config.latencyReport = true;
+    } else if (arg == "--log-timestamps") {
+      config.logTimestamps = true;
+    } else if (arg == "--strategy" && hasValue) {
+      config.strategy = argv[++i];
+    } else if (arg == "--seed" && hasValue) {
+      config.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--think-dist" && hasValue) {
+      if (!parseDistribution(argv[++i], config.thinkDistribution)) {
+        printUsage(argv[0]);
+        return false;
+      }
+    } else if (arg == "--eat-dist" && hasValue) {
+      if (!parseDistribution(argv[++i], config.eatDistribution)) {
+        printUsage(argv[0]);
+        return false;
+      }
+    } else {
+      positional.push_back(argv[i]);
+    }
+  }
+  argc = (int)positional.size();
+  argv = positional.data();
+
+  if (argc < 3) {
+    printUsage(argv[0]);
+    return false;
+  }
+
+  // Проверяем режим работы программы
+  std::string mode = argv[1];
+  if (mode == "-c" && (argc == 8 || argc == 9)) {
+    // Режим командной строки
+    if (!parseDuration(argv[2], config.minThink) ||
+        !parseDuration(argv[3], config.maxThink) ||
+        !parseDuration(argv[4], config.minEat) ||
+        !parseDuration(argv[5], config.maxEat) ||
+        !parseDuration(argv[6], config.simulationTime)) {
+      printUsage(argv[0]);
+      return false;
+    }
+    if (argc == 9) {
+      config.numPhilosophers = std::atoi(argv[7]);
+    }
+    config.outputPath = argv[argc - 1];
+  } else if (mode == "-f" && argc == 4) {
+    // Режим конфигурационного файла
+    if (!readConfigFromFile(argv[2], config)) {
+      return false;
+    }
+    config.outputPath = argv[3];
+  } else {
+    printUsage(argv[0]);
+    return false;
+  }
+  return true;
+}
+
+bool takeFlag(int& argc, char* argv[], const std::string& flag) {
+  bool found = false;
+  int kept = 0;
+  for (int i = 0; i < argc; ++i) {
+    if (i > 0 && flag == argv[i]) {
+      found = true;
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+  return found;
+}
+
+bool takeOption(int& argc, char* argv[], const std::string& flag,
+                std::string& value) {
+  bool found = false;
+  int kept = 0;
+  for (int i = 0; i < argc; ++i) {
+    if (i > 0 && i + 1 < argc && flag == argv[i]) {
+      found = true;
+      value = argv[++i];
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+  return found;
+}
@@ -0,0 +1,87 @@
+#ifndef ENGINE_CONFIG_H
+#define ENGINE_CONFIG_H
+
+#include <cstdint>
+#include <string>
+
+#include "random_source.h"
+#include "thread_pinning.h"
+
+// Количество философов по умолчанию и допустимые границы
+const int DEFAULT_PHILOSOPHERS = 5;
+const int MIN_PHILOSOPHERS = 2;
+const int MAX_PHILOSOPHERS = 1000000;
+
+// Сколько раз младшие соседи могут поесть раньше ждущего (стратегия aging)
+const int DEFAULT_MAX_BYPASS = 2;
+
+// Границы времени симуляции и наименьшая длительность фазы
+const Duration MIN_SIMULATION_TIME = std::chrono::seconds(10);
+const Duration MAX_SIMULATION_TIME = std::chrono::seconds(100);
+const Duration MIN_PHASE_TIME = std::chrono::microseconds(1);
+
+// Чем исполняются философы
+enum class Executor {
+  Threads,     // поток на философа
+  Tasks,       // конечные автоматы на планировщике M:N
+  Coroutines,  // корутины C++20 на планировщике M:N
+};
+
+const char* executorName(Executor executor);
+
+// Структура для хранения конфигурации
+struct Config {
+  Duration minThink{};
+  Duration maxThink{};
+  Duration minEat{};
+  Duration maxEat{};
+  Duration simulationTime{};
+  int numPhilosophers{DEFAULT_PHILOSOPHERS};
+  std::string strategy;    // стратегия распределения вилок
+  std::string outputPath;  // файл журнала, пустой - только консоль
+  std::string statsPath;   // JSON со счётчиками философов, пустой - нет
+  // Двоичная трасса событий вместо строк журнала, пустой - журнал
+  std::string tracePath;
+  bool virtualTime{};
+  Executor executor{Executor::Threads};
+  // Число рабочих потоков планировщика M:N, 0 - по потоку на процессор
+  int workers{};
+  int maxBypass{DEFAULT_MAX_BYPASS};
+  // Привязка потоков философов к процессорам; validateConfig() допускает
+  // её только с Executor::Threads
+  PinPolicy pin{PinPolicy::None};
+  bool logTimestamps{};
+  // Печатать перцентили задержки от голода до еды
+  bool latencyReport{};
+  uint64_t seed{};
+  Distribution thinkDistribution{Distribution::Uniform};
+  Distribution eatDistribution{Distribution::Uniform};
+
+  PhaseTime think() const { return {minThink, maxThink, thinkDistribution}; }
+  PhaseTime eat() const { return {minEat, maxEat, eatDistribution}; }
+};
+
+// Проверка диапазонов; фазы - от MIN_PHASE_TIME до maxPhaseTime
+bool validateConfig(const Config& config,
+                    Duration maxPhaseTime = std::chrono::seconds(10));
+
+// Длительность с суффиксом ns, us, ms или s ("250us", "1.5ms"); число без
+// суффикса - секунды, как в прежних конфигурациях
+bool parseDuration(const std::string& text, Duration& duration);
+
+bool readConfigFromFile(const std::string& filename, Config& config);
+
+void printUsage(const char* programName);
+
+// Разбор режимов -c/-f и флагов. Стратегия в config сохраняется, если она
+// не задана флагом --strategy.
+bool parseArguments(int argc, char* argv[], Config& config);
+
+// Убирает флаг из argv, если он есть, и сообщает, был ли он. Для решений с
+// позиционными параметрами без parseArguments().
+bool takeFlag(int& argc, char* argv[], const std::string& flag);
+// То же для флага со значением: убирает "flag value" и сохраняет value
+bool takeOption(int& argc, char* argv[], const std::string& flag,
+                std::string& value);
+
+#endif  // ENGINE_CONFIG_H
@@ -0,0 +1,211 @@
+#include "coro_table.h"
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "simulation.h"
+#include "task_forks.h"
+#include "task_scheduler.h"
+
+namespace {
+
+// Корутина философа. Её promise - задача планировщика: run() возобновляет
+// корутину до следующего co_await. Корутина создаётся приостановленной и
+// уничтожается владельцем.
+class PhilosopherCoroutine {
+ public:
+  struct promise_type : Task {
+    PhilosopherCoroutine get_return_object() {
+      return PhilosopherCoroutine(Handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+
+    void run() override { Handle::from_promise(*this).resume(); }
+  };
+  using Handle = std::coroutine_handle<promise_type>;
+
+  explicit PhilosopherCoroutine(Handle handle) : handle_(handle) {}
+  PhilosopherCoroutine(PhilosopherCoroutine&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  PhilosopherCoroutine(const PhilosopherCoroutine&) = delete;
+  PhilosopherCoroutine& operator=(const PhilosopherCoroutine&) = delete;
+  ~PhilosopherCoroutine() {
+    if (handle_) handle_.destroy();
+  }
+
+  Task* task() { return &handle_.promise(); }
+
+ private:
+  Handle handle_;
+};
+
+using Handle = PhilosopherCoroutine::Handle;
+
+// Приостанавливает корутину до момента when
+struct SleepAwaiter {
+  TaskScheduler* scheduler;
+  std::chrono::steady_clock::time_point when;
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(Handle handle) {
+    scheduler->scheduleAt(&handle.promise(), when);
+  }
+  void await_resume() const noexcept {}
+};
+
+// Берёт разрешение семафора. Если разрешений нет, корутина ждёт в очереди
+// семафора, и её возобновит тот, кто вернёт разрешение. После постановки в
+// очередь awaiter не трогает своих полей: корутину уже могут возобновить,
+// поэтому waited выставляется заранее. co_await возвращает, пришлось ли
+// ждать.
+struct SemaphoreAwaiter {
+  TaskSemaphore* sem;
+  bool waited = true;
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(Handle handle) {
+    if (!sem->tryAcquire(&handle.promise())) return true;
+    waited = false;
+    return false;
+  }
+  bool await_resume() const noexcept { return waited; }
+};
+
+// Берёт обе вилки разом (протокол bothForks)
+struct BothForksAwaiter {
+  TaskForkMonitor* monitor;
+  int philosopher;
+  bool waited = true;
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(Handle handle) {
+    if (!monitor->tryTakeBoth(philosopher, &handle.promise())) return true;
+    waited = false;
+    return false;
+  }
+  bool await_resume() const noexcept { return waited; }
+};
+
+// Общее состояние корутин философов и фабрика awaiter-ов
+struct CoroTable {
+  Table* table;
+  TaskScheduler* scheduler;
+  TaskForkTable* forks;
+
+  SleepAwaiter pause(Duration duration) {
+    return {scheduler, std::chrono::steady_clock::now() + duration};
+  }
+  SemaphoreAwaiter acquire(TaskSemaphore& sem) { return {&sem}; }
+  BothForksAwaiter acquireBoth(int philosopher) {
+    return {&forks->monitor, philosopher};
+  }
+
+  // Возвращает разрешение и возобновляет получившую его корутину
+  void release(TaskSemaphore& sem) {
+    if (Task* waiter = sem.release()) {
+      scheduler->schedule(waiter);
+    }
+  }
+  void releaseBoth(int philosopher) {
+    Task* woken[2];
+    int count = forks->monitor.putBoth(philosopher, woken);
+    for (int i = 0; i < count; ++i) {
+      scheduler->schedule(woken[i]);
+    }
+  }
+};
+
+// Тот же цикл, что philosopherLoop(), но ожидания - точки приостановки
+PhilosopherCoroutine philosopherCoroutine(CoroTable& t, Philosopher& self) {
+  Table& table = *t.table;
+  const Config& config = *table.config;
+  TaskForkTable& forks = *t.forks;
+  int first = forks.first[self.id];
+  int second = forks.second[self.id];
+
+  while (table.running) {
+    // Философ размышляет
+    Duration thinkTime = self.random.time(config.think());
+    table.report(self, EventType::Think, -1, thinkTime.count());
+    co_await t.pause(thinkTime);
+    if (!table.running) break;
+
+    // Философ голоден и берёт вилки по протоколу стратегии
+    table.report(self, EventType::Hungry, -1, 0);
+    auto hungry = std::chrono::steady_clock::now();
+    if (forks.protocol.bothForks) {
+      table.report(self, EventType::TakeFork, first, 0);
+      table.report(self, EventType::TakeFork, second, 0);
+      if (co_await t.acquireBoth(self.id)) {
+        table.report(self, EventType::ForkBusy, -1, 0);
+      }
+    } else {
+      if (forks.protocol.useStopper) {
+        table.report(self, EventType::WaitPermission, -1, 0);
+        co_await t.acquire(forks.stopper);
+      }
+      table.report(self, EventType::TakeFork, first, 0);
+      if (co_await t.acquire(forks.forks[first])) {
+        table.report(self, EventType::ForkBusy, first, 0);
+      }
+      table.report(self, EventType::TakeFork, second, 0);
+      if (co_await t.acquire(forks.forks[second])) {
+        table.report(self, EventType::ForkBusy, second, 0);
+      }
+    }
+    if (!table.running) break;
+    table.recordWait(self, std::chrono::steady_clock::now() - hungry);
+
+    // Начинает есть
+    Duration eatTime = self.random.time(config.eat());
+    table.report(self, EventType::Eat, -1, eatTime.count());
+    co_await t.pause(eatTime);
+    if (!table.running) break;
+
+    // Закончил есть
+    table.report(self, EventType::PutDown, -1, 0);
+    if (forks.protocol.bothForks) {
+      t.releaseBoth(self.id);
+    } else {
+      t.release(forks.forks[second]);
+      t.release(forks.forks[first]);
+      if (forks.protocol.useStopper) {
+        t.release(forks.stopper);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void launchCoroutines(Table& table, std::vector<Philosopher>& philosophers) {
+  VirtualProtocol protocol{};
+  if (!table.arbiter->virtualProtocol(protocol)) {
+    table.print("Стратегия " + std::string(table.arbiter->name()) +
+                " не поддерживает режим корутин.");
+    table.running.cancel();
+    return;
+  }
+
+  TaskScheduler scheduler(table.config->workers);
+  TaskForkTable forks((int)philosophers.size(), protocol);
+  CoroTable shared{&table, &scheduler, &forks};
+
+  std::vector<PhilosopherCoroutine> coroutines;
+  coroutines.reserve(philosophers.size());
+  for (auto& philosopher : philosophers) {
+    coroutines.push_back(philosopherCoroutine(shared, philosopher));
+  }
+
+  scheduler.start();
+  for (auto& coroutine : coroutines) {
+    scheduler.schedule(coroutine.task());
+  }
+  waitForTimeout(table);
+  // Корутины, оставшиеся в очередях, уничтожаются вместе с coroutines
+  scheduler.stop();
+}
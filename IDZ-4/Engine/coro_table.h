@@ -0,0 +1,17 @@
+#ifndef ENGINE_CORO_TABLE_H
+#define ENGINE_CORO_TABLE_H
+
+#include <vector>
+
+#include "philosopher.h"
+
+// Режим корутин (--coroutines): цикл философа записан последовательно, как
+// philosopherLoop(), но размышление, еда и ожидание вилок - это co_await,
+// которые приостанавливают корутину, а не поток. Корутины исполняет тот же
+// планировщик M:N, что и режим задач (config.workers рабочих потоков, 1 -
+// однопоточный исполнитель), вилки и блокировщик устроены по протоколу
+// ForkArbiter::virtualProtocol(). Кадр корутины занимает сотни байт, поэтому
+// в одном процессе помещаются миллионы философов.
+void launchCoroutines(Table& table, std::vector<Philosopher>& philosophers);
+
+#endif  // ENGINE_CORO_TABLE_H
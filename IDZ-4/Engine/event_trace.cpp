@@ -0,0 +1,181 @@
+#include "event_trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+thread_local TraceWriter::Block TraceWriter::localBlock_;
+
+namespace {
+
+const size_t HEADER_SIZE = sizeof(TraceHeader);
+const size_t RECORD_SIZE = sizeof(TraceRecord);
+// Файл растёт кусками по 64 МБ; до записи они разрежены и места не занимают
+const uint64_t GROW_RECORDS = (64 << 20) / RECORD_SIZE;
+// Адресное пространство под отображение: сколько удастся из 256 ГБ.
+// Отображение не переезжает, поэтому рост файла не мешает пишущим потокам.
+const size_t MAX_RESERVE = size_t(1) << 38;
+const size_t MIN_RESERVE = size_t(1) << 26;
+
+std::atomic<uint64_t> nextWriterId{1};
+
+}  // namespace
+
+TraceRecord encodeEvent(const Event& event) {
+  TraceRecord record{};
+  record.time = event.time;
+  record.value = event.value;
+  record.philosopher = event.philosopher;
+  record.forkAndType =
+      (uint32_t)(event.fork + 1) << 8 | ((uint32_t)event.type + 1);
+  return record;
+}
+
+Event decodeEvent(const TraceRecord& record) {
+  return {record.time, record.philosopher,
+          (EventType)((record.forkAndType & 0xff) - 1),
+          (int)(record.forkAndType >> 8) - 1, record.value};
+}
+
+TraceWriter::~TraceWriter() { close(); }
+
+bool TraceWriter::open(const std::string& path, LogStyle style) {
+  style_ = style;
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) return false;
+  for (reserved_ = MAX_RESERVE; reserved_ >= MIN_RESERVE; reserved_ /= 2) {
+    void* map = mmap(nullptr, reserved_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_NORESERVE, fd_, 0);
+    if (map != MAP_FAILED) {
+      map_ = static_cast<char*>(map);
+      break;
+    }
+  }
+  id_ = nextWriterId++;
+  if (!map_ || !grow(GROW_RECORDS)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// Файл дорастает до records слотов. Потоки, которым хватает уже выделенного
+// места, мьютекс не берут.
+bool TraceWriter::grow(uint64_t records) {
+  std::lock_guard<std::mutex> lock(growMutex_);
+  if (capacity_.load(std::memory_order_relaxed) >= records) return true;
+  uint64_t capacity =
+      (records + GROW_RECORDS - 1) / GROW_RECORDS * GROW_RECORDS;
+  if (HEADER_SIZE + capacity * RECORD_SIZE > reserved_ ||
+      ftruncate(fd_, (off_t)(HEADER_SIZE + capacity * RECORD_SIZE)) != 0) {
+    overflow_ = true;
+    return false;
+  }
+  capacity_.store(capacity, std::memory_order_release);
+  return true;
+}
+
+bool TraceWriter::reserve(Block& block) {
+  uint64_t first =
+      nextRecord_.fetch_add(BLOCK_RECORDS, std::memory_order_relaxed);
+  uint64_t end = first + BLOCK_RECORDS;
+  if (end > capacity_.load(std::memory_order_acquire) && !grow(end)) {
+    return false;
+  }
+  block = {id_, first, end};
+  return true;
+}
+
+void TraceWriter::write(const Event& event) {
+  Block& block = localBlock_;
+  if ((block.owner != id_ || block.next == block.end) && !reserve(block)) {
+    return;
+  }
+  auto* records = reinterpret_cast<TraceRecord*>(map_ + HEADER_SIZE);
+  records[block.next++] = encodeEvent(event);
+}
+
+bool TraceWriter::close() {
+  if (fd_ < 0) return false;
+  bool ok = map_ != nullptr && !overflow_;
+  uint64_t records = std::min(nextRecord_.load(), capacity_.load());
+  if (map_) {
+    TraceHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.recordSize = RECORD_SIZE;
+    header.records = records;
+    header.logStyle = (uint32_t)style_;
+    std::memcpy(map_, &header, HEADER_SIZE);
+    munmap(map_, reserved_);
+    map_ = nullptr;
+  }
+  ok &= ftruncate(fd_, (off_t)(HEADER_SIZE + records * RECORD_SIZE)) == 0;
+  ok &= ::close(fd_) == 0;
+  fd_ = -1;
+  return ok;
+}
+
+TraceReader::~TraceReader() {
+  if (map_) munmap(map_, size_);
+}
+
+bool TraceReader::later(const Cursor& a, const Cursor& b) {
+  return a.time != b.time ? a.time > b.time : a.slot > b.slot;
+}
+
+bool TraceReader::open(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st{};
+  void* map = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size >= HEADER_SIZE) {
+    map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if (map == MAP_FAILED) return false;
+  map_ = map;
+  size_ = st.st_size;
+
+  const auto* header = static_cast<const TraceHeader*>(map_);
+  if (std::memcmp(header->magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+      header->version != TRACE_VERSION || header->recordSize != RECORD_SIZE ||
+      header->records > (size_ - HEADER_SIZE) / RECORD_SIZE ||
+      header->logStyle > (uint32_t)LogStyle::Stopper) {
+    return false;
+  }
+  style_ = (LogStyle)header->logStyle;
+  records_ = reinterpret_cast<const TraceRecord*>(
+      static_cast<const char*>(map_) + HEADER_SIZE);
+
+  // Блоки выровнены по BLOCK_RECORDS от начала; пустые слоты бывают только
+  // в хвосте блока
+  uint64_t count = header->records;
+  for (uint64_t slot = 0; slot < count; slot += TraceWriter::BLOCK_RECORDS) {
+    if (records_[slot].forkAndType != 0) {
+      heap_.push_back({records_[slot].time, slot,
+                       std::min(slot + TraceWriter::BLOCK_RECORDS, count)});
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), later);
+  return true;
+}
+
+bool TraceReader::next(Event& event) {
+  if (heap_.empty()) return false;
+  std::pop_heap(heap_.begin(), heap_.end(), later);
+  Cursor& cursor = heap_.back();
+  event = decodeEvent(records_[cursor.slot]);
+  ++cursor.slot;
+  if (cursor.slot < cursor.end && records_[cursor.slot].forkAndType != 0) {
+    cursor.time = records_[cursor.slot].time;
+    std::push_heap(heap_.begin(), heap_.end(), later);
+  } else {
+    heap_.pop_back();
+  }
+  return true;
+}
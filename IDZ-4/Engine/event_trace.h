@@ -0,0 +1,121 @@
+#ifndef ENGINE_EVENT_TRACE_H
+#define ENGINE_EVENT_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "events.h"
+
+// Двоичная трасса событий: заголовок и записи фиксированного размера.
+// Записи одного потока идут по порядку, записи разных потоков
+// перемешаны блоками, поэтому читатель упорядочивает их по времени.
+struct TraceHeader {
+  char magic[8];  // TRACE_MAGIC
+  uint32_t version;
+  uint32_t recordSize;
+  uint64_t records;  // число слотов после заголовка, включая пустые
+  uint32_t logStyle;  // LogStyle журнала, в котором печатать события
+  uint32_t reserved;
+};
+
+struct TraceRecord {
+  int64_t time;  // микросекунды от начала симуляции
+  int64_t value;  // длительность для Think/Eat в наносекундах, иначе 0
+  int32_t philosopher;
+  // (fork + 1) << 8 | (type + 1); 0 - пустой слот, который поток
+  // зарезервировал, но не заполнил
+  uint32_t forkAndType;
+};
+
+const char TRACE_MAGIC[8] = {'P', 'H', 'I', 'L', 'O', 'T', 'R', 'C'};
+const uint32_t TRACE_VERSION = 2;
+
+TraceRecord encodeEvent(const Event& event);
+Event decodeEvent(const TraceRecord& record);
+
+// Пишет трассу в файл, отображённый в память. Поток резервирует блок слотов
+// одним fetch_add и заполняет его без синхронизации; файл растёт кусками
+// под мьютексом. Вместо ~80 байт строки и выделения памяти на событие -
+// 24 байта и запись в отображение.
+class TraceWriter {
+ public:
+  // Слотов в блоке потока: пустые хвосты блоков ограничены 1,5 КБ на поток
+  static constexpr size_t BLOCK_RECORDS = 64;
+
+  TraceWriter() = default;
+  ~TraceWriter();
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  // style сохраняется в заголовке для печати трассы в виде журнала
+  bool open(const std::string& path, LogStyle style = LogStyle::Default);
+  // Безопасно из любого потока между open() и close()
+  void write(const Event& event);
+  // Дописывает заголовок и обрезает файл. Вызывать, когда писатели
+  // завершены. Возвращает false, если запись не удалась или события
+  // не поместились в файл.
+  bool close();
+
+ private:
+  struct Block {
+    uint64_t owner = 0;  // id_ трассы, для которой зарезервирован блок
+    uint64_t next = 0;
+    uint64_t end = 0;
+  };
+
+  bool reserve(Block& block);
+  bool grow(uint64_t records);
+
+  uint64_t id_ = 0;
+  LogStyle style_ = LogStyle::Default;
+  int fd_ = -1;
+  char* map_ = nullptr;
+  size_t reserved_ = 0;  // байт адресного пространства под отображение
+  std::mutex growMutex_;
+  std::atomic<uint64_t> capacity_{0};  // слотов в файле
+  alignas(64) std::atomic<uint64_t> nextRecord_{0};
+  std::atomic<bool> overflow_{false};
+
+  static thread_local Block localBlock_;
+};
+
+// Читает трассу потоком. Записи отображены в память, а события выдаются
+// по времени слиянием блоков: каждый блок заполнял один поток, поэтому он
+// уже упорядочен. В памяти - только курсоры блоков (1/64 числа записей).
+// События с равным временем идут в порядке файла.
+class TraceReader {
+ public:
+  TraceReader() = default;
+  ~TraceReader();
+  TraceReader(const TraceReader&) = delete;
+  TraceReader& operator=(const TraceReader&) = delete;
+
+  bool open(const std::string& path);
+  // Следующее по времени событие; false, когда события кончились
+  bool next(Event& event);
+  // Стиль журнала, с которым записывалась трасса
+  LogStyle logStyle() const { return style_; }
+
+ private:
+  struct Cursor {
+    int64_t time;  // время записи slot
+    uint64_t slot;
+    uint64_t end;
+  };
+
+  // Порядок кучи курсоров: наверху самое раннее событие, при равном
+  // времени - раньше записанное в файл
+  static bool later(const Cursor& a, const Cursor& b);
+
+  void* map_ = nullptr;
+  size_t size_ = 0;
+  const TraceRecord* records_ = nullptr;
+  LogStyle style_ = LogStyle::Default;
+  std::vector<Cursor> heap_;
+};
+
+#endif  // ENGINE_EVENT_TRACE_H
@@ -0,0 +1,82 @@
+#include "events.h"
+
+namespace {
+
+struct DurationUnit {
+  int64_t nanos;
+  const char* name;
+};
+
+const DurationUnit DURATION_UNITS[] = {
+    {1000000000, "секунд"}, {1000000, "мс"}, {1000, "мкс"}, {1, "нс"}};
+
+}  // namespace
+
+std::string formatDurationRange(std::chrono::nanoseconds min,
+                                std::chrono::nanoseconds max) {
+  for (const DurationUnit& unit : DURATION_UNITS) {
+    if (min.count() % unit.nanos != 0 || max.count() % unit.nanos != 0) {
+      continue;
+    }
+    std::string value = std::to_string(min.count() / unit.nanos);
+    if (max != min) {
+      value += "-" + std::to_string(max.count() / unit.nanos);
+    }
+    return value + " " + unit.name;
+  }
+  return "";
+}
+
+std::string formatDuration(std::chrono::nanoseconds duration) {
+  return formatDurationRange(duration, duration);
+}
+
+std::string formatEvent(const Event& event, LogStyle style) {
+  bool stopper = style == LogStyle::Stopper;
+  std::string name = "Философ " + std::to_string(event.philosopher);
+  switch (event.type) {
+    case EventType::Think:
+      return name + " думает в течение " +
+             formatDuration(std::chrono::nanoseconds(event.value)) + ".";
+    case EventType::Hungry:
+      // С блокировщиком голод печатается вместе с запросом разрешения
+      return stopper ? "" : name + " проголодался.";
+    case EventType::WaitPermission:
+      return name + (stopper ? " голоден и ждет" : " ждет") +
+             " разрешения брать вилки.";
+    case EventType::TakeFork:
+      // Левая вилка философа имеет его номер, правая - номер соседа
+      return name + " пытается взять " +
+             (event.fork == event.philosopher ? "левую" : "правую") +
+             " вилку " + std::to_string(event.fork) + ".";
+    case EventType::Eat:
+      return name + " ест в течение " +
+             formatDuration(std::chrono::nanoseconds(event.value)) + ".";
+    case EventType::PutDown:
+      return name + " закончил есть и кладет вилки " +
+             (stopper ? "назад " : "") + "на стол.";
+    case EventType::ForkBusy:
+      return name + " ждет занятую вилку.";
+  }
+  return name;
+}
+
+const char* eventName(EventType type) {
+  switch (type) {
+    case EventType::Think:
+      return "think";
+    case EventType::Hungry:
+      return "hungry";
+    case EventType::WaitPermission:
+      return "wait_permission";
+    case EventType::TakeFork:
+      return "take_fork";
+    case EventType::Eat:
+      return "eat";
+    case EventType::PutDown:
+      return "put_down";
+    case EventType::ForkBusy:
+      return "fork_busy";
+  }
+  return "unknown";
+}
@@ -0,0 +1,46 @@
+#ifndef ENGINE_EVENTS_H
+#define ENGINE_EVENTS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Тип события в журнале философов
+enum class EventType {
+  Think,           // начал размышлять (value - длительность)
+  Hungry,          // проголодался
+  WaitPermission,  // ждёт разрешения блокировщика брать вилки
+  TakeFork,        // пытается взять вилку (fork - номер вилки)
+  Eat,             // начал есть (value - длительность)
+  PutDown,         // закончил есть и положил вилки
+  ForkBusy,        // вилка занята (fork - номер или -1); только в статистику
+};
+
+// Событие философа
+struct Event {
+  int64_t time;  // микросекунды от начала симуляции
+  int philosopher;
+  EventType type;
+  int fork;       // номер вилки для TakeFork, иначе -1
+  int64_t value;  // длительность для Think/Eat в наносекундах, иначе 0
+};
+
+// Формулировки журнала. Solution_1..3 с семафором-блокировщиком печатали
+// голод и запрос разрешения одной строкой и клали вилки "назад на стол";
+// стиль Stopper сохраняет их журнал для стратегий с блокировщиком.
+enum class LogStyle { Default, Stopper };
+
+// Строка журнала для события; пустая - событие в этом стиле не печатается
+std::string formatEvent(const Event& event,
+                        LogStyle style = LogStyle::Default);
+// Короткое имя типа для CSV: "think", "take_fork"
+const char* eventName(EventType type);
+
+// Длительность в самых крупных единицах, в которых она целая:
+// "3 секунд", "250 мс", "40 мкс"
+std::string formatDuration(std::chrono::nanoseconds duration);
+// Отрезок длительностей в общих единицах: "1-10 секунд", "500-2000 мкс"
+std::string formatDurationRange(std::chrono::nanoseconds min,
+                                std::chrono::nanoseconds max);
+
+#endif  // ENGINE_EVENTS_H
@@ -0,0 +1,70 @@
+#include "fork_arbiter.h"
+
+#include "asymmetric_arbiter.h"
+#include "chandy_misra_arbiter.h"
+#include "monitor_arbiter.h"
+#include "observer_arbiter.h"
+#include "ordered_arbiter.h"
+#include "sharded_observer.h"
+#include "stopper_arbiter.h"
+#include "waiter_arbiter.h"
+
+std::unique_ptr<ForkArbiter> makeArbiter(const std::string& name,
+                                         int numPhilosophers, int maxBypass) {
+  if (name == "stopper") {
+    return std::make_unique<StopperArbiter<SemaphoreForkLock>>(
+        numPhilosophers, "stopper");
+  }
+  if (name == "stopper-futex") {
+    return std::make_unique<StopperArbiter<FutexForkLock>>(numPhilosophers,
+                                                           "stopper-futex");
+  }
+  if (name == "observer") {
+    return std::make_unique<ObserverArbiter<ForkObserver>>(numPhilosophers,
+                                                           "observer");
+  }
+  if (name == "observer-sharded") {
+    return std::make_unique<ObserverArbiter<ShardedForkObserver>>(
+        numPhilosophers, "observer-sharded");
+  }
+  if (name == "ordered") {
+    return std::make_unique<OrderedArbiter<FutexForkLock>>(numPhilosophers,
+                                                           "ordered");
+  }
+  if (name == "asymmetric") {
+    return std::make_unique<AsymmetricArbiter>(numPhilosophers);
+  }
+  if (name == "ordered-sem") {
+    return std::make_unique<OrderedArbiter<SemaphoreForkLock>>(
+        numPhilosophers, "ordered-sem");
+  }
+  if (name == "monitor") {
+    return std::make_unique<MonitorArbiter>(numPhilosophers);
+  }
+  if (name == "chandy-misra") {
+    return std::make_unique<ChandyMisraArbiter>(numPhilosophers);
+  }
+  if (name == "waiter") {
+    return std::make_unique<WaiterArbiter>(numPhilosophers, "waiter");
+  }
+  if (name == "aging") {
+    return std::make_unique<WaiterArbiter>(numPhilosophers, "aging",
+                                           maxBypass);
+  }
+  return nullptr;
+}
+
+const std::vector<std::string>& arbiterNames() {
+  static const std::vector<std::string> names = {
+      "stopper",      "stopper-futex", "observer", "observer-sharded",
+      "ordered",      "ordered-sem",   "monitor",  "chandy-misra",
+      "asymmetric",   "waiter",        "aging"};
+  return names;
+}
+
+LogStyle logStyleOf(const ForkArbiter& arbiter) {
+  VirtualProtocol protocol{};
+  return arbiter.virtualProtocol(protocol) && protocol.useStopper
+             ? LogStyle::Stopper
+             : LogStyle::Default;
+}
@@ -0,0 +1,69 @@
+#ifndef ENGINE_FORK_ARBITER_H
+#define ENGINE_FORK_ARBITER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cancellation.h"
+#include "config.h"
+#include "events.h"
+#include "virtual_time.h"
+
+// Сообщает о промежуточных шагах захвата вилок (ожидание блокировщика,
+// попытка взять вилку) в журнал философа
+using EventReporter = std::function<void(EventType type, int fork)>;
+
+// Стратегия распределения вилок между философами.
+// Философ i пользуется левой вилкой i и правой вилкой (i + 1) % N; стратегия
+// решает, в каком порядке и под какой защитой он их берёт.
+class ForkArbiter {
+ public:
+  explicit ForkArbiter(int numPhilosophers)
+      : numPhilosophers_(numPhilosophers) {}
+  virtual ~ForkArbiter() = default;
+
+  virtual const char* name() const = 0;
+
+  // Блокирует философа, пока он не возьмёт обе вилки. Возвращает false, если
+  // программа завершается; в этом случае философ не держит ни одной вилки.
+  virtual bool acquire(int philosopher, const CancellationToken& running,
+                       const EventReporter& report) = 0;
+  virtual void release(int philosopher) = 0;
+  // Будит всех философов, ждущих в acquire(): они возвращают false, не
+  // держа вилок. Вызывается после отмены running.
+  virtual void cancel() = 0;
+
+  // Больше всего обедов соседей за одно ожидание по учёту самой стратегии
+  // (от прихода заявки до выдачи вилок); -1 - стратегия его не ведёт
+  virtual long maxNeighbourMeals() const { return -1; }
+
+  // Вызывается в потоке философа перед его циклом: стратегия может привязать
+  // поток к процессорам, рядом с которыми лежат её данные
+  virtual void bindThread(int philosopher) { (void)philosopher; }
+
+  // Протокол для режима виртуального времени, если стратегия его описывает
+  virtual bool virtualProtocol(VirtualProtocol& protocol) const {
+    (void)protocol;
+    return false;
+  }
+
+  int leftFork(int philosopher) const { return philosopher; }
+  int rightFork(int philosopher) const {
+    return (philosopher + 1) % numPhilosophers_;
+  }
+
+ protected:
+  int numPhilosophers_;
+};
+
+// Создаёт стратегию по имени или возвращает nullptr
+std::unique_ptr<ForkArbiter> makeArbiter(
+    const std::string& name, int numPhilosophers,
+    int maxBypass = DEFAULT_MAX_BYPASS);
+const std::vector<std::string>& arbiterNames();
+// Стиль журнала стратегии: с блокировщиком - как в Solution_1..3
+LogStyle logStyleOf(const ForkArbiter& arbiter);
+
+#endif  // ENGINE_FORK_ARBITER_H
@@ -0,0 +1,74 @@
+#include "fork_lock.h"
+
+#include <algorithm>
+
+#include "futex.h"
+
+namespace {
+
+const int MAX_SPINS = 100;
+const uint32_t LOCKED = 1;
+const uint32_t WAITER = 2;
+const uint32_t CANCELLED = 1u << 31;
+
+}  // namespace
+
+bool FutexForkLock::tryLock() {
+  uint32_t state = state_.load(std::memory_order_relaxed);
+  return (state & (LOCKED | CANCELLED)) == 0 &&
+         state_.compare_exchange_strong(state, state | LOCKED,
+                                        std::memory_order_acquire);
+}
+
+bool FutexForkLock::lock() {
+  uint32_t expected = 0;
+  if (state_.compare_exchange_strong(expected, LOCKED,
+                                     std::memory_order_acquire)) {
+    return true;
+  }
+
+  // Прокрутка: вилку часто кладут раньше, чем поток успел бы заснуть
+  int estimate = spinEstimate_.load(std::memory_order_relaxed);
+  int limit = spinningHelps() ? std::min(MAX_SPINS, 2 * estimate + 10) : 0;
+  for (int spins = 1; spins <= limit; ++spins) {
+    cpuRelax();
+    if (tryLock()) {
+      spinEstimate_.store(estimate + (spins - estimate) / 8,
+                          std::memory_order_relaxed);
+      return true;
+    }
+  }
+  spinEstimate_.store(estimate + (limit - estimate) / 8,
+                      std::memory_order_relaxed);
+
+  // Засыпание: регистрируемся в слове и спим, пока вилка занята. futex
+  // проверяет, что слово не изменилось, поэтому освобождение между
+  // проверкой и засыпанием не теряется.
+  uint32_t state = state_.fetch_add(WAITER, std::memory_order_relaxed) + WAITER;
+  while (true) {
+    if (state & CANCELLED) {
+      state_.fetch_sub(WAITER, std::memory_order_relaxed);
+      return false;
+    }
+    if ((state & LOCKED) == 0 &&
+        state_.compare_exchange_weak(state, (state | LOCKED) - WAITER,
+                                     std::memory_order_acquire)) {
+      return true;
+    }
+    if (state & LOCKED) {
+      futexWait(&state_, state);
+      state = state_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void FutexForkLock::unlock() {
+  if (state_.fetch_sub(LOCKED, std::memory_order_release) != LOCKED) {
+    futexWakeOne(&state_);
+  }
+}
+
+void FutexForkLock::cancel() {
+  state_.fetch_or(CANCELLED);
+  futexWakeAll(&state_);
+}
@@ -0,0 +1,73 @@
+#ifndef ENGINE_FORK_LOCK_H
+#define ENGINE_FORK_LOCK_H
+
+#include <semaphore.h>
+
+#include <atomic>
+#include <cstdint>
+
+// Вилка на двоичном семафоре POSIX, как в исходных Solution_1..3.
+// Отмена пробуждает ждущих эстафетой: cancel() отдаёт одно разрешение, и
+// каждый проснувшийся возвращает его следующему.
+class SemaphoreForkLock {
+ public:
+  SemaphoreForkLock() { sem_init(&sem_, 0, 1); }
+  ~SemaphoreForkLock() { sem_destroy(&sem_); }
+  SemaphoreForkLock(const SemaphoreForkLock&) = delete;
+  SemaphoreForkLock& operator=(const SemaphoreForkLock&) = delete;
+
+  // Возвращает false, если вилка отменена; тогда она не взята
+  bool lock() {
+    sem_wait(&sem_);
+    if (cancelled_.load(std::memory_order_acquire)) {
+      sem_post(&sem_);
+      return false;
+    }
+    return true;
+  }
+  bool tryLock() {
+    if (sem_trywait(&sem_) != 0) return false;
+    if (cancelled_.load(std::memory_order_acquire)) {
+      sem_post(&sem_);
+      return false;
+    }
+    return true;
+  }
+  void unlock() { sem_post(&sem_); }
+  // Будит всех ждущих; после этого lock() сразу возвращает false
+  void cancel() {
+    cancelled_.store(true, std::memory_order_release);
+    sem_post(&sem_);
+  }
+
+ private:
+  sem_t sem_;
+  std::atomic<bool> cancelled_{false};
+};
+
+// Вилка прямо на futex(2). Сначала несколько итераций крутится в
+// пространстве пользователя (длина прокрутки подстраивается под то, сколько
+// обычно приходится ждать), затем засыпает в ядре. Младший бит слова -
+// вилка занята, старший - вилка отменена, остальные - число спящих:
+// unlock() одной атомарной операцией освобождает вилку и узнаёт, нужен ли
+// системный вызов.
+class FutexForkLock {
+ public:
+  FutexForkLock() = default;
+  FutexForkLock(const FutexForkLock&) = delete;
+  FutexForkLock& operator=(const FutexForkLock&) = delete;
+
+  bool tryLock();
+  // Возвращает false, если вилка отменена; тогда она не взята
+  bool lock();
+  void unlock();
+  // Будит всех спящих; после этого lock() и tryLock() возвращают false
+  void cancel();
+
+ private:
+  std::atomic<uint32_t> state_{0};
+  // Сглаженная длина успешной прокрутки, как у адаптивного мьютекса glibc
+  std::atomic<int> spinEstimate_{0};
+};
+
+#endif  // ENGINE_FORK_LOCK_H
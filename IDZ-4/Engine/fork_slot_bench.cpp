@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "observer_arbiter.h"
+#include "perf_counter.h"
+
+namespace {
+
+// Прежняя раскладка ForkObserver: биты vector<bool> под общим мьютексом
+class PackedBoolTable {
+ public:
+  explicit PackedBoolTable(int n) : forks_(n, true), n_(n) {}
+
+  bool tryTakeLeftFork(int p) { return tryTake(p); }
+  bool tryTakeRightFork(int p) { return tryTake((p + 1) % n_); }
+  void putDownLeftFork(int p) { putDown(p); }
+  void putDownForks(int p) {
+    putDown(p);
+    putDown((p + 1) % n_);
+  }
+
+ private:
+  bool tryTake(int fork) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!forks_[fork]) return false;
+    forks_[fork] = false;
+    return true;
+  }
+  void putDown(int fork) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    forks_[fork] = true;
+  }
+
+  std::vector<bool> forks_;
+  std::mutex mutex_;
+  int n_;
+};
+
+// Те же CAS, что в ForkObserver, но слоты идут подряд: восемь вилок делят
+// одну кэш-линию
+class PackedAtomicTable {
+ public:
+  explicit PackedAtomicTable(int n) : forks_(n), n_(n) {}
+
+  bool tryTakeLeftFork(int p) { return tryTake(p, p); }
+  bool tryTakeRightFork(int p) { return tryTake((p + 1) % n_, p); }
+  void putDownLeftFork(int p) { putDown(p); }
+  void putDownForks(int p) {
+    putDown(p);
+    putDown((p + 1) % n_);
+  }
+
+ private:
+  bool tryTake(int fork, int p) {
+    uint64_t state = forks_[fork].load();
+    if ((state & 0xffffffffu) != 0) return false;
+    return forks_[fork].compare_exchange_strong(state, state | (p + 1));
+  }
+  void putDown(int fork) {
+    uint64_t state = forks_[fork].load(std::memory_order_relaxed);
+    forks_[fork].store((state & ~uint64_t(0xffffffffu)) + (uint64_t(1) << 32));
+  }
+
+  std::vector<std::atomic<uint64_t>> forks_;
+  int n_;
+};
+
+struct Measurement {
+  double cyclesPerSecond = 0;
+  double missesPerCycle = -1;  // -1 - счётчик недоступен
+};
+
+// Поток t работает только за местом 2t: его вилки 2t и 2t + 1 не нужны
+// никому другому, поэтому весь обмен кэш-линиями между ядрами - ложное
+// разделение соседних слотов
+template <typename Table>
+Measurement measure(int threads, std::chrono::milliseconds duration) {
+  Table table(2 * threads);
+  std::atomic<bool> running{true};
+  std::vector<long> cycles(threads, 0);
+  CacheMissCounter counter;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      int seat = 2 * t;
+      long count = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        if (!table.tryTakeLeftFork(seat)) continue;
+        if (table.tryTakeRightFork(seat)) {
+          table.putDownForks(seat);
+          ++count;
+        } else {
+          table.putDownLeftFork(seat);
+        }
+      }
+      cycles[t] = count;
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(duration);
+  running = false;
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  long total = 0;
+  for (long c : cycles) {
+    total += c;
+  }
+  Measurement result;
+  result.cyclesPerSecond = total / elapsed.count();
+  long long misses = counter.read();
+  if (misses >= 0 && total > 0) {
+    result.missesPerCycle = (double)misses / total;
+  }
+  return result;
+}
+
+void printRow(const char* layout, int threads, const Measurement& m) {
+  if (m.missesPerCycle < 0) {
+    std::printf("%-18s %7d %14.0f %16s\n", layout, threads, m.cyclesPerSecond,
+                "n/a");
+  } else {
+    std::printf("%-18s %7d %14.0f %16.3f\n", layout, threads,
+                m.cyclesPerSecond, m.missesPerCycle);
+  }
+  std::fflush(stdout);
+}
+
+}  // namespace
+
+// Сравнивает раскладки таблицы вилок по числу циклов "взять - положить" в
+// секунду и промахам кэша на цикл
+int main(int argc, char* argv[]) {
+  long durationMs = 1000;
+  int maxThreads = std::max(1, (int)std::thread::hardware_concurrency());
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--threads" && hasValue) {
+      maxThreads = std::atoi(argv[++i]);
+    } else if (arg == "--duration-ms" && hasValue) {
+      durationMs = std::atol(argv[++i]);
+    } else {
+      std::cerr << "Использование: " << argv[0]
+                << " [--threads T] [--duration-ms MS]\n";
+      return 1;
+    }
+  }
+  if (maxThreads < 1 || durationMs < 1) {
+    std::cerr << "Неправильные значения параметров\n";
+    return 1;
+  }
+
+  std::chrono::milliseconds duration(durationMs);
+  std::printf("%-18s %7s %14s %16s\n", "layout", "threads", "cycles/s",
+              "misses/cycle");
+  for (int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+    printRow("vector<bool>+mutex", threads,
+             measure<PackedBoolTable>(threads, duration));
+    printRow("packed atomics", threads,
+             measure<PackedAtomicTable>(threads, duration));
+    printRow("padded slots", threads,
+             measure<ForkObserver>(threads, duration));
+    if (threads == maxThreads) break;
+  }
+  return 0;
+}
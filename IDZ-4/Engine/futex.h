@@ -0,0 +1,45 @@
+#ifndef ENGINE_FUTEX_H
+#define ENGINE_FUTEX_H
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+// Тонкие обёртки над futex(2) для слов внутри одного процесса
+
+// Спит, пока *word == expected и не истёк timeout (nullptr - без срока)
+inline void futexWait(std::atomic<uint32_t>* word, uint32_t expected,
+                      const timespec* timeout = nullptr) {
+  syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+inline void futexWakeOne(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+inline void futexWakeAll(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Пауза в цикле прокрутки перед засыпанием на futex
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// На одном процессоре тот, кого мы ждём, не может продвинуться, пока мы
+// крутимся, поэтому прокрутка только отнимает у него квант времени
+inline bool spinningHelps() {
+  static const bool helps = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+  return helps;
+}
+
+#endif  // ENGINE_FUTEX_H
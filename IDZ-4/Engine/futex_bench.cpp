@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fork_lock.h"
+
+namespace {
+
+// Стоимость пары lock/unlock одним потоком, нс
+template <typename Lock>
+double uncontended(long iterations) {
+  Lock lock;
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; ++i) {
+    lock.lock();
+    lock.unlock();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+// threads потоков делят одну вилку; возвращает пары lock/unlock в секунду
+template <typename Lock>
+double contended(int threads, std::chrono::milliseconds duration) {
+  Lock lock;
+  std::atomic<bool> running{true};
+  std::vector<long> pairs(threads, 0);
+  long shared = 0;  // защищаемые вилкой данные
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      long count = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        lock.lock();
+        ++shared;
+        lock.unlock();
+        ++count;
+      }
+      pairs[t] = count;
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(duration);
+  running = false;
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  long total = 0;
+  for (long p : pairs) {
+    total += p;
+  }
+  return total / elapsed.count();
+}
+
+}  // namespace
+
+// Сравнивает вилку на sem_t, вилку на futex и std::mutex
+int main(int argc, char* argv[]) {
+  long iterations = 10000000;
+  long durationMs = 1000;
+  int maxThreads = std::max(2, (int)std::thread::hardware_concurrency());
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--iterations" && hasValue) {
+      iterations = std::atol(argv[++i]);
+    } else if (arg == "--threads" && hasValue) {
+      maxThreads = std::atoi(argv[++i]);
+    } else if (arg == "--duration-ms" && hasValue) {
+      durationMs = std::atol(argv[++i]);
+    } else {
+      std::cerr << "Использование: " << argv[0]
+                << " [--iterations N] [--threads T] [--duration-ms MS]\n";
+      return 1;
+    }
+  }
+  if (iterations < 1 || maxThreads < 2 || durationMs < 1) {
+    std::cerr << "Неправильные значения параметров\n";
+    return 1;
+  }
+
+  std::printf("Без конкуренции, нс на lock+unlock:\n");
+  std::printf("  sem_t      %8.2f\n",
+              uncontended<SemaphoreForkLock>(iterations));
+  std::printf("  futex      %8.2f\n", uncontended<FutexForkLock>(iterations));
+  std::printf("  std::mutex %8.2f\n", uncontended<std::mutex>(iterations));
+
+  std::chrono::milliseconds duration(durationMs);
+  std::printf("\nС конкуренцией, lock+unlock в секунду:\n");
+  std::printf("%7s %14s %14s %14s\n", "threads", "sem_t", "futex",
+              "std::mutex");
+  for (int threads = 2;; threads = std::min(threads * 2, maxThreads)) {
+    std::printf("%7d %14.0f %14.0f %14.0f\n", threads,
+                contended<SemaphoreForkLock>(threads, duration),
+                contended<FutexForkLock>(threads, duration),
+                contended<std::mutex>(threads, duration));
+    std::fflush(stdout);
+    if (threads == maxThreads) break;
+  }
+  return 0;
+}
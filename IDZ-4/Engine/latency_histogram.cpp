@@ -0,0 +1,114 @@
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const int HALF_BUCKETS = LatencyHistogram::SUB_BUCKETS / 2;
+const int64_t MAX_VALUE =
+    (int64_t(1) << LatencyHistogram::MAX_VALUE_BITS) - 1;
+const int COUNTS_SIZE =
+    (LatencyHistogram::MAX_VALUE_BITS - LatencyHistogram::SUB_BUCKET_BITS +
+     2) *
+    HALF_BUCKETS;
+
+std::atomic<uint64_t> nextRecorderId{1};
+
+// Гистограмма потока для последнего сборщика, в который он писал
+struct LocalHistogram {
+  uint64_t recorder = 0;
+  LatencyHistogram* histogram = nullptr;
+};
+thread_local LocalHistogram localHistogram;
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : counts_(COUNTS_SIZE, 0) {}
+
+// Корзина 0 покрывает [0, SUB_BUCKETS) с шагом 1, корзина b > 0 -
+// [2^(b + 6), 2^(b + 7)) с шагом 2^b; в индексе у каждой корзины, кроме
+// нулевой, только верхняя половина подкорзин
+int LatencyHistogram::indexOf(int64_t value) {
+  value = std::clamp<int64_t>(value, 0, MAX_VALUE);
+  int magnitude =
+      64 - __builtin_clzll((uint64_t)value | (uint64_t)(SUB_BUCKETS - 1));
+  int bucket = magnitude - SUB_BUCKET_BITS;
+  int sub = (int)(value >> bucket);
+  return ((bucket + 1) * HALF_BUCKETS) + sub - HALF_BUCKETS;
+}
+
+int64_t LatencyHistogram::highestEquivalent(int index) {
+  int bucket = index / HALF_BUCKETS - 1;
+  int64_t sub = index % HALF_BUCKETS + HALF_BUCKETS;
+  if (bucket < 0) {
+    bucket = 0;
+    sub -= HALF_BUCKETS;
+  }
+  return (sub << bucket) + (int64_t(1) << bucket) - 1;
+}
+
+void LatencyHistogram::record(int64_t value) {
+  ++counts_[indexOf(value)];
+  ++total_;
+  max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  total_ += other.total_;
+  max_ = std::max(max_, other.max_);
+}
+
+int64_t LatencyHistogram::percentile(double q) const {
+  if (total_ == 0) return 0;
+  uint64_t target =
+      std::max<uint64_t>(1, (uint64_t)std::ceil(q * (double)total_));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= target) {
+      return std::min(highestEquivalent((int)i), max_);
+    }
+  }
+  return max_;
+}
+
+LatencyRecorder::LatencyRecorder() : id_(nextRecorderId++) {}
+
+LatencyHistogram* LatencyRecorder::local() {
+  if (localHistogram.recorder != id_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    histograms_.push_back(std::make_unique<LatencyHistogram>());
+    localHistogram = {id_, histograms_.back().get()};
+  }
+  return localHistogram.histogram;
+}
+
+void LatencyRecorder::record(int64_t value) { local()->record(value); }
+
+LatencyHistogram LatencyRecorder::merged() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LatencyHistogram result;
+  for (const auto& histogram : histograms_) {
+    result.merge(*histogram);
+  }
+  return result;
+}
+
+std::string formatLatencyReport(const LatencyHistogram& histogram) {
+  char line[200];
+  std::snprintf(line, sizeof(line),
+                "Задержка от голода до еды (%llu ожиданий), мс: p50 %.3f, "
+                "p90 %.3f, p99 %.3f, p99.9 %.3f, max %.3f",
+                (unsigned long long)histogram.count(),
+                histogram.percentile(0.5) / 1e6,
+                histogram.percentile(0.9) / 1e6,
+                histogram.percentile(0.99) / 1e6,
+                histogram.percentile(0.999) / 1e6, histogram.max() / 1e6);
+  return line;
+}
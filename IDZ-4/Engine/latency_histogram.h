@@ -0,0 +1,67 @@
+#ifndef ENGINE_LATENCY_HISTOGRAM_H
+#define ENGINE_LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Гистограмма в духе HdrHistogram: логарифмически-линейные корзины.
+// Каждая степень двойки делится на SUB_BUCKETS / 2 равных корзин, поэтому
+// значение восстанавливается с относительной ошибкой не больше 1/64 при
+// фиксированном размере (16 КБ) на диапазоне от 1 нс до 2^36 нс (~69 с);
+// более длинные значения попадают в последнюю корзину, максимум хранится
+// точно. Запись - сдвиг и инкремент, без выделения памяти.
+class LatencyHistogram {
+ public:
+  static constexpr int SUB_BUCKET_BITS = 7;
+  static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr int MAX_VALUE_BITS = 36;
+
+  LatencyHistogram();
+
+  void record(int64_t value);
+  void merge(const LatencyHistogram& other);
+
+  uint64_t count() const { return total_; }
+  int64_t max() const { return max_; }
+  // Значение, не меньше которого q (0..1) всех записей; 0 без записей
+  int64_t percentile(double q) const;
+
+ private:
+  static int indexOf(int64_t value);
+  // Наибольшее значение, попадающее в корзину index
+  static int64_t highestEquivalent(int index);
+
+  std::vector<uint64_t> counts_;
+  uint64_t total_ = 0;
+  int64_t max_ = 0;
+};
+
+// Сборщик задержек от голода до еды. Каждый поток пишет в собственную
+// гистограмму без синхронизации (мьютекс берётся только при первой записи
+// потока), а merged() сливает их, когда все потоки завершены. В режимах
+// задач и корутин гистограмма своя у каждого рабочего потока.
+class LatencyRecorder {
+ public:
+  LatencyRecorder();
+  LatencyRecorder(const LatencyRecorder&) = delete;
+  LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+  // Записывает задержку в нс в гистограмму вызывающего потока
+  void record(int64_t value);
+  LatencyHistogram merged();
+
+ private:
+  LatencyHistogram* local();
+
+  const uint64_t id_;  // отличает сборщик в кэше потока
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms_;
+};
+
+// Строка отчёта: p50/p90/p99/p99.9/max в миллисекундах
+std::string formatLatencyReport(const LatencyHistogram& histogram);
+
+#endif  // ENGINE_LATENCY_HISTOGRAM_H
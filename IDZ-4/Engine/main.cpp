@@ -0,0 +1,21 @@
+#include <iostream>
+
+#include "config.h"
+#include "simulation.h"
+
+// Единый исполняемый файл: стратегия распределения вилок выбирается флагом
+// --strategy, поэтому все стратегии сравниваются при одинаковой нагрузке
+int main(int argc, char* argv[]) {
+  Config config;
+  config.strategy = "stopper";
+  if (!parseArguments(argc, argv, config)) {
+    return 1;
+  }
+
+  if (!validateConfig(config, std::chrono::seconds(30))) {
+    std::cerr << "Неправильные значения параметров\n";
+    return 1;
+  }
+
+  return runSimulation(config);
+}
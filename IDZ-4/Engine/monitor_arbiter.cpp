@@ -0,0 +1,52 @@
+#include "monitor_arbiter.h"
+
+bool MonitorArbiter::acquire(int philosopher, const CancellationToken& running,
+                             const EventReporter& report) {
+  report(EventType::TakeFork, leftFork(philosopher));
+  report(EventType::TakeFork, rightFork(philosopher));
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  state_[philosopher] = State::Hungry;
+  test(philosopher);
+  if (state_[philosopher] != State::Eating) {
+    report(EventType::ForkBusy, -1);
+  }
+  while (state_[philosopher] != State::Eating && running) {
+    canEat_[philosopher].wait(lock);
+  }
+  if (state_[philosopher] != State::Eating) {
+    state_[philosopher] = State::Thinking;
+    return false;
+  }
+  return true;
+}
+
+void MonitorArbiter::release(int philosopher) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  state_[philosopher] = State::Thinking;
+  test((philosopher + numPhilosophers_ - 1) % numPhilosophers_);
+  test((philosopher + 1) % numPhilosophers_);
+}
+
+// Ждущие проверяют running под mutex_, поэтому уведомление не теряется
+void MonitorArbiter::cancel() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& cond : canEat_) {
+    cond.notify_all();
+  }
+}
+
+void MonitorArbiter::test(int philosopher) {
+  int left = (philosopher + numPhilosophers_ - 1) % numPhilosophers_;
+  int right = (philosopher + 1) % numPhilosophers_;
+  if (state_[philosopher] == State::Hungry &&
+      state_[left] != State::Eating && state_[right] != State::Eating) {
+    state_[philosopher] = State::Eating;
+    canEat_[philosopher].notify_one();
+  }
+}
+
+bool MonitorArbiter::virtualProtocol(VirtualProtocol& protocol) const {
+  protocol = {false, false, true, false};
+  return true;
+}
@@ -0,0 +1,38 @@
+#ifndef ENGINE_MONITOR_ARBITER_H
+#define ENGINE_MONITOR_ARBITER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "fork_arbiter.h"
+
+// Монитор Таненбаума: философ берёт обе вилки сразу и только тогда, когда ни
+// один из соседей не ест. Вилка никогда не удерживается в одиночку, поэтому
+// тупик невозможен.
+class MonitorArbiter : public ForkArbiter {
+ public:
+  explicit MonitorArbiter(int numPhilosophers)
+      : ForkArbiter(numPhilosophers),
+        state_(numPhilosophers, State::Thinking),
+        canEat_(numPhilosophers) {}
+
+  const char* name() const override { return "monitor"; }
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override;
+  void release(int philosopher) override;
+  void cancel() override;
+  bool virtualProtocol(VirtualProtocol& protocol) const override;
+
+ private:
+  enum class State { Thinking, Hungry, Eating };
+
+  // Разрешает голодному философу есть, если соседи не едят
+  void test(int philosopher);
+
+  std::mutex mutex_;
+  std::vector<State> state_;
+  std::vector<std::condition_variable> canEat_;
+};
+
+#endif  // ENGINE_MONITOR_ARBITER_H
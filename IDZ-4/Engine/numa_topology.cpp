@@ -0,0 +1,99 @@
+#include "numa_topology.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+const char* const NODE_DIRECTORY = "/sys/devices/system/node";
+
+// Номера узлов из имён каталогов nodeN, по возрастанию
+std::vector<int> listNodes() {
+  std::vector<int> nodes;
+  DIR* directory = opendir(NODE_DIRECTORY);
+  if (!directory) return nodes;
+  while (dirent* entry = readdir(directory)) {
+    std::string name = entry->d_name;
+    if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+        name.find_first_not_of("0123456789", 4) == std::string::npos) {
+      nodes.push_back(std::atoi(name.c_str() + 4));
+    }
+  }
+  closedir(directory);
+  std::sort(nodes.begin(), nodes.end());
+  return nodes;
+}
+
+}  // namespace
+
+bool parseCpuList(const std::string& text, std::vector<int>& cpus) {
+  cpus.clear();
+  size_t position = 0;
+  while (position < text.size() && text[position] != '\n') {
+    char* end = nullptr;
+    long first = std::strtol(text.c_str() + position, &end, 10);
+    if (end == text.c_str() + position || first < 0) return false;
+    long last = first;
+    if (*end == '-') {
+      const char* begin = end + 1;
+      last = std::strtol(begin, &end, 10);
+      if (end == begin || last < first) return false;
+    }
+    for (long cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back((int)cpu);
+    }
+    position = end - text.c_str();
+    if (*end == ',') {
+      ++position;
+    } else if (*end != '\0' && *end != '\n') {
+      return false;
+    }
+  }
+  return true;
+}
+
+NumaTopology NumaTopology::detect() {
+  NumaTopology topology;
+  for (int node : listNodes()) {
+    std::ifstream file(std::string(NODE_DIRECTORY) + "/node" +
+                       std::to_string(node) + "/cpulist");
+    std::string text;
+    std::vector<int> cpus;
+    if (std::getline(file, text) && parseCpuList(text, cpus) &&
+        !cpus.empty()) {
+      topology.cpus_.push_back(std::move(cpus));
+    }
+  }
+  if (topology.cpus_.empty()) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    std::vector<int> cpus;
+    for (long cpu = 0; cpu < std::max(count, 1L); ++cpu) {
+      cpus.push_back((int)cpu);
+    }
+    topology.cpus_.push_back(std::move(cpus));
+  }
+  return topology;
+}
+
+int NumaTopology::nodeOfSeat(int seat, int numPhilosophers) const {
+  return (int)((long)seat * nodes() / numPhilosophers);
+}
+
+int NumaTopology::firstSeat(int node, int numPhilosophers) const {
+  return (int)(((long)node * numPhilosophers + nodes() - 1) / nodes());
+}
+
+bool NumaTopology::bindThread(int node) const {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus_[node]) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
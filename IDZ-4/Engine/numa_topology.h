@@ -0,0 +1,32 @@
+#ifndef ENGINE_NUMA_TOPOLOGY_H
+#define ENGINE_NUMA_TOPOLOGY_H
+
+#include <string>
+#include <vector>
+
+// Узлы NUMA машины и процессоры каждого узла по /sys/devices/system/node.
+// Узлы без процессоров (только память) пропускаются. Без sysfs или на машине
+// без NUMA получается один узел со всеми процессорами.
+class NumaTopology {
+ public:
+  static NumaTopology detect();
+
+  int nodes() const { return (int)cpus_.size(); }
+  const std::vector<int>& cpus(int node) const { return cpus_[node]; }
+
+  // Места за столом делятся на nodes() непрерывных диапазонов почти равной
+  // длины; узел места seat и первое место диапазона узла node
+  int nodeOfSeat(int seat, int numPhilosophers) const;
+  int firstSeat(int node, int numPhilosophers) const;
+
+  // Привязывает текущий поток к процессорам узла; false - не удалось
+  bool bindThread(int node) const;
+
+ private:
+  std::vector<std::vector<int>> cpus_;
+};
+
+// Разбирает список процессоров sysfs вида "0-3,8,10-11"
+bool parseCpuList(const std::string& text, std::vector<int>& cpus);
+
+#endif  // ENGINE_NUMA_TOPOLOGY_H
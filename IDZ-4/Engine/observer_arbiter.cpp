@@ -0,0 +1,120 @@
+#include "observer_arbiter.h"
+
+namespace {
+
+const uint64_t OWNER_MASK = 0xffffffffu;
+const uint64_t GENERATION_STEP = uint64_t(1) << 32;
+
+}  // namespace
+
+ForkObserver::ForkObserver(int num_philosophers)
+    : forks(num_philosophers),
+      fork_cv(num_philosophers),
+      philosophers(num_philosophers),
+      num_philosophers(num_philosophers) {}
+
+bool ForkObserver::tryTake(int fork, int philosopher_id) {
+  uint64_t state = forks[fork].state.load();
+  if ((state & OWNER_MASK) != 0) {
+    return false;
+  }
+  // Поколение в ожидаемом значении не даёт выиграть CAS по устаревшему
+  // снимку, даже если вилку успели взять и положить
+  uint64_t taken = (state & ~OWNER_MASK) | (uint64_t)(philosopher_id + 1);
+  return forks[fork].state.compare_exchange_strong(state, taken);
+}
+
+void ForkObserver::putDown(int fork) {
+  // Кладёт вилку только владелец, поэтому достаточно простой записи
+  uint64_t state = forks[fork].state.load(std::memory_order_relaxed);
+  forks[fork].state.store((state & ~OWNER_MASK) + GENERATION_STEP);
+}
+
+void ForkObserver::wake(int philosopher_id, bool locked) {
+  // Пара seq_cst-операций (waiting в takeForks, состояние вилки в putDown)
+  // гарантирует: либо ждущий увидит свободную вилку, либо мы увидим его флаг
+  if (!philosophers[philosopher_id].waiting.load()) {
+    return;
+  }
+  if (locked) {
+    fork_cv[philosopher_id].notify_one();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(observer_mutex);
+  fork_cv[philosopher_id].notify_one();
+}
+
+bool ForkObserver::tryTakeBoth(int philosopher_id, bool locked) {
+  if (!tryTake(philosopher_id, philosopher_id)) {
+    return false;
+  }
+  if (tryTake((philosopher_id + 1) % num_philosophers, philosopher_id)) {
+    return true;
+  }
+  // Правая занята: возвращаем левую и будим соседа, который мог её ждать
+  putDown(philosopher_id);
+  wake((philosopher_id + num_philosophers - 1) % num_philosophers, locked);
+  return false;
+}
+
+bool ForkObserver::tryTakeLeftFork(int philosopher_id) {
+  return tryTake(philosopher_id, philosopher_id);
+}
+
+bool ForkObserver::tryTakeRightFork(int philosopher_id) {
+  if (!tryTake((philosopher_id + 1) % num_philosophers, philosopher_id)) {
+    return false;
+  }
+  philosophers[philosopher_id].eating.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void ForkObserver::putDownLeftFork(int philosopher_id) {
+  putDown(philosopher_id);
+  wake((philosopher_id + num_philosophers - 1) % num_philosophers, false);
+}
+
+void ForkObserver::putDownForks(int philosopher_id) {
+  putDown(philosopher_id);                           // левая вилка
+  putDown((philosopher_id + 1) % num_philosophers);  // правая вилка
+  philosophers[philosopher_id].eating.store(false, std::memory_order_relaxed);
+
+  // Уведомляем соседей
+  wake((philosopher_id + num_philosophers - 1) % num_philosophers, false);
+  wake((philosopher_id + 1) % num_philosophers, false);
+}
+
+bool ForkObserver::takeForks(int philosopher_id,
+                             const CancellationToken& running,
+                             const EventReporter& report) {
+  // Быстрый путь: обе вилки свободны, мьютекс не нужен
+  bool taken = tryTakeBoth(philosopher_id, false);
+  if (!taken) {
+    report(EventType::ForkBusy, -1);
+    std::unique_lock<std::mutex> lock(observer_mutex);
+    philosophers[philosopher_id].waiting = true;
+    // Проверка вилок и засыпание происходят под одним захватом мьютекса,
+    // а wake() берёт его перед уведомлением, поэтому оно не теряется
+    fork_cv[philosopher_id].wait(lock, [&] {
+      taken = running && tryTakeBoth(philosopher_id, true);
+      if (!taken && running) {
+        report(EventType::ForkBusy, -1);
+      }
+      return taken || !running;
+    });
+    philosophers[philosopher_id].waiting = false;
+  }
+  if (!taken) {
+    return false;
+  }
+
+  philosophers[philosopher_id].eating.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void ForkObserver::cancel() {
+  std::lock_guard<std::mutex> lock(observer_mutex);
+  for (auto& cv : fork_cv) {
+    cv.notify_all();
+  }
+}
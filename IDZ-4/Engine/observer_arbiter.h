@@ -0,0 +1,95 @@
+#ifndef ENGINE_OBSERVER_ARBITER_H
+#define ENGINE_OBSERVER_ARBITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "cancellation.h"
+#include "fork_arbiter.h"
+
+// Класс наблюдателя для управления вилками (Solution_4).
+// Состояние вилки - атомарный слот в своей кэш-линии: номер владельца и
+// счётчик поколений. Вилки берутся и кладутся CAS-операциями без
+// observer_mutex; мьютекс и условные переменные нужны только философу,
+// которому пришлось ждать, и тому, кто его будит.
+class ForkObserver {
+ private:
+  // Младшие 32 бита - владелец + 1 (0 - вилка свободна), старшие - номер
+  // поколения, который растёт при каждом освобождении вилки
+  struct alignas(64) ForkSlot {
+    std::atomic<uint64_t> state{0};
+  };
+  struct alignas(64) SeatSlot {
+    std::atomic<bool> eating{false};
+    std::atomic<bool> waiting{false};  // философ спит в takeForks
+  };
+
+  std::vector<ForkSlot> forks;
+  std::vector<std::condition_variable> fork_cv;
+  std::mutex observer_mutex;
+  std::vector<SeatSlot> philosophers;
+  int num_philosophers;
+
+  bool tryTake(int fork, int philosopher_id);
+  void putDown(int fork);
+  // Занимает обе вилки или ни одной; locked - observer_mutex уже захвачен
+  bool tryTakeBoth(int philosopher_id, bool locked);
+  void wake(int philosopher_id, bool locked);
+
+ public:
+  explicit ForkObserver(int num_philosophers);
+
+  bool tryTakeLeftFork(int philosopher_id);
+  bool tryTakeRightFork(int philosopher_id);
+  // Возвращает только левую вилку, если правую взять не успели
+  void putDownLeftFork(int philosopher_id);
+  void putDownForks(int philosopher_id);
+  // Берёт обе вилки сразу или ждёт, пока обе освободятся; каждая неудачная
+  // попытка отмечается событием ForkBusy. Возвращает false, если running
+  // сброшен; тогда вилки не взяты.
+  bool takeForks(int philosopher_id, const CancellationToken& running,
+                 const EventReporter& report);
+  // Будит всех ждущих в takeForks() после отмены running
+  void cancel();
+};
+
+// Философ берёт обе вилки у наблюдателя одной операцией и ждёт
+// уведомления соседа, пока хотя бы одна из них занята. Observer -
+// ForkObserver или ShardedForkObserver.
+template <typename Observer>
+class ObserverArbiter : public ForkArbiter {
+ public:
+  ObserverArbiter(int numPhilosophers, const char* name)
+      : ForkArbiter(numPhilosophers),
+        observer_(numPhilosophers),
+        name_(name) {}
+
+  const char* name() const override { return name_; }
+
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override {
+    report(EventType::TakeFork, leftFork(philosopher));
+    report(EventType::TakeFork, rightFork(philosopher));
+    return observer_.takeForks(philosopher, running, report);
+  }
+
+  void release(int philosopher) override {
+    observer_.putDownForks(philosopher);
+  }
+
+  void cancel() override { observer_.cancel(); }
+
+  bool virtualProtocol(VirtualProtocol& protocol) const override {
+    protocol = {false, false, true, false};
+    return true;
+  }
+
+ private:
+  Observer observer_;
+  const char* name_;
+};
+
+#endif  // ENGINE_OBSERVER_ARBITER_H
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "observer_arbiter.h"
+#include "sharded_observer.h"
+
+namespace {
+
+// Каждый поток обслуживает свой непрерывный блок мест и в цикле берёт и
+// кладёт вилки без ожидания и сна. Так измеряется только стоимость
+// синхронизации наблюдателя: соседние блоки делят лишь граничные вилки.
+template <typename Observer>
+double measure(int seats, int threads, std::chrono::milliseconds duration) {
+  Observer observer(seats);
+  std::atomic<bool> running{true};
+  std::vector<long> meals(threads, 0);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      int first = (int)((long)seats * t / threads);
+      int last = (int)((long)seats * (t + 1) / threads);
+      long count = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        for (int seat = first; seat < last; ++seat) {
+          if (!observer.tryTakeLeftFork(seat)) continue;
+          if (observer.tryTakeRightFork(seat)) {
+            observer.putDownForks(seat);
+            ++count;
+          } else {
+            observer.putDownLeftFork(seat);
+          }
+        }
+      }
+      meals[t] = count;
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(duration);
+  running = false;
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  long total = 0;
+  for (long m : meals) {
+    total += m;
+  }
+  return total / elapsed.count();
+}
+
+}  // namespace
+
+// Сравнивает ForkObserver (CAS над атомарными слотами вилок в отдельных
+// кэш-линиях) с ShardedForkObserver (мьютекс на каждую вилку и место) по
+// числу циклов "взять - положить" в секунду
+int main(int argc, char* argv[]) {
+  int seats = 10000;
+  long durationMs = 1000;
+  int maxThreads = std::max(1, (int)std::thread::hardware_concurrency());
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--seats" && hasValue) {
+      seats = std::atoi(argv[++i]);
+    } else if (arg == "--threads" && hasValue) {
+      maxThreads = std::atoi(argv[++i]);
+    } else if (arg == "--duration-ms" && hasValue) {
+      durationMs = std::atol(argv[++i]);
+    } else {
+      std::cerr << "Использование: " << argv[0]
+                << " [--seats N] [--threads T] [--duration-ms MS]\n";
+      return 1;
+    }
+  }
+  if (seats < 2 || maxThreads < 1 || maxThreads > seats || durationMs < 1) {
+    std::cerr << "Неправильные значения параметров\n";
+    return 1;
+  }
+
+  std::chrono::milliseconds duration(durationMs);
+  std::printf("%7s %8s %14s %14s %8s\n", "threads", "seats", "observer/s",
+              "sharded/s", "speedup");
+  for (int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+    double single = measure<ForkObserver>(seats, threads, duration);
+    double sharded = measure<ShardedForkObserver>(seats, threads, duration);
+    std::printf("%7d %8d %14.0f %14.0f %7.2fx\n", threads, seats, single,
+                sharded, sharded / single);
+    std::fflush(stdout);
+    if (threads == maxThreads) break;
+  }
+  return 0;
+}
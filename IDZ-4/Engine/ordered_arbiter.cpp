@@ -0,0 +1,66 @@
+#include "ordered_arbiter.h"
+
+#include <algorithm>
+
+template <typename ForkLock>
+OrderedArbiter<ForkLock>::OrderedArbiter(int numPhilosophers, const char* name)
+    : ForkArbiter(numPhilosophers), forks_(numPhilosophers), name_(name) {}
+
+template <typename ForkLock>
+bool OrderedArbiter<ForkLock>::acquire(int philosopher,
+                                       const CancellationToken& running,
+                                       const EventReporter& report) {
+  int firstFork = std::min(leftFork(philosopher), rightFork(philosopher));
+  int secondFork = std::max(leftFork(philosopher), rightFork(philosopher));
+
+  // Берем первую вилку
+  if (!take(firstFork, report)) {
+    return false;
+  }
+  if (!running) {
+    forks_[firstFork].unlock();
+    return false;
+  }
+
+  // Берем вторую вилку
+  if (!take(secondFork, report)) {
+    forks_[firstFork].unlock();
+    return false;
+  }
+  return true;
+}
+
+template <typename ForkLock>
+bool OrderedArbiter<ForkLock>::take(int fork, const EventReporter& report) {
+  report(EventType::TakeFork, fork);
+  if (forks_[fork].tryLock()) {
+    return true;
+  }
+  report(EventType::ForkBusy, fork);
+  return forks_[fork].lock();
+}
+
+template <typename ForkLock>
+void OrderedArbiter<ForkLock>::release(int philosopher) {
+  int firstFork = std::min(leftFork(philosopher), rightFork(philosopher));
+  int secondFork = std::max(leftFork(philosopher), rightFork(philosopher));
+  forks_[secondFork].unlock();
+  forks_[firstFork].unlock();
+}
+
+template <typename ForkLock>
+void OrderedArbiter<ForkLock>::cancel() {
+  for (auto& fork : forks_) {
+    fork.cancel();
+  }
+}
+
+template <typename ForkLock>
+bool OrderedArbiter<ForkLock>::virtualProtocol(
+    VirtualProtocol& protocol) const {
+  protocol = {false, true, false, false};
+  return true;
+}
+
+template class OrderedArbiter<SemaphoreForkLock>;
+template class OrderedArbiter<FutexForkLock>;
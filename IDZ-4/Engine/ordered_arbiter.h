@@ -0,0 +1,35 @@
+#ifndef ENGINE_ORDERED_ARBITER_H
+#define ENGINE_ORDERED_ARBITER_H
+
+#include <vector>
+
+#include "fork_arbiter.h"
+#include "fork_lock.h"
+
+// Иерархия ресурсов (Solution_5): первой берётся вилка с меньшим номером,
+// поэтому цикл ожидания не может замкнуться, и общий блокировщик не нужен:
+// философы соперничают только за свои две вилки. ForkLock - тип вилки:
+// FutexForkLock (ordered) или SemaphoreForkLock на sem_t, как в
+// Solution_1..3 (ordered-sem).
+template <typename ForkLock>
+class OrderedArbiter : public ForkArbiter {
+ public:
+  OrderedArbiter(int numPhilosophers, const char* name);
+
+  const char* name() const override { return name_; }
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override;
+  void release(int philosopher) override;
+  void cancel() override;
+  bool virtualProtocol(VirtualProtocol& protocol) const override;
+
+ private:
+  // Берёт вилку; занятая вилка отмечается событием ForkBusy. Возвращает
+  // false при отмене.
+  bool take(int fork, const EventReporter& report);
+
+  std::vector<ForkLock> forks_;
+  const char* name_;
+};
+
+#endif  // ENGINE_ORDERED_ARBITER_H
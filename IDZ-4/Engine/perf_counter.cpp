@@ -0,0 +1,36 @@
+#include "perf_counter.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+CacheMissCounter::CacheMissCounter() {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  fd_ = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  if (fd_ >= 0) {
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+CacheMissCounter::~CacheMissCounter() {
+  if (fd_ >= 0) close(fd_);
+}
+
+long long CacheMissCounter::read() const {
+  long long value = 0;
+  if (fd_ < 0 || ::read(fd_, &value, sizeof(value)) != sizeof(value)) {
+    return -1;
+  }
+  return value;
+}
@@ -0,0 +1,23 @@
+#ifndef ENGINE_PERF_COUNTER_H
+#define ENGINE_PERF_COUNTER_H
+
+// Счётчик промахов кэша для процесса и его будущих потоков (perf_event_open
+// с inherit): значения завершившихся потоков складываются в наш. Ближайшая
+// общедоступная замена HITM-событиям perf c2c; без PMU (в виртуальной
+// машине, при perf_event_paranoid > 2) недоступен.
+class CacheMissCounter {
+ public:
+  CacheMissCounter();
+  ~CacheMissCounter();
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+  bool available() const { return fd_ >= 0; }
+  // Вызывать после завершения потоков; -1 - счётчик недоступен
+  long long read() const;
+
+ private:
+  int fd_ = -1;
+};
+
+#endif  // ENGINE_PERF_COUNTER_H
@@ -0,0 +1,112 @@
+#include "philosopher.h"
+
+#include <iostream>
+#include <thread>
+
+void Table::print(const std::string& message) {
+  if (logger) {
+    logger->log(message);
+  } else {
+    std::cerr << message << "\n";
+  }
+}
+
+void Table::report(Philosopher& self, EventType type, int fork,
+                   int64_t value) {
+  self.stats.count(type, value);
+  if (type == EventType::Hungry && philosophers) {
+    self.stats.neighbourMealsAtHungry = neighbourMeals(self);
+  }
+  if ((!logger && !trace) || type == EventType::ForkBusy) return;
+  auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+  Event event{now, self.id, type, fork, value};
+  if (trace) {
+    trace->write(event);
+    return;
+  }
+  std::string line = formatEvent(event, logStyle);
+  if (!line.empty()) {
+    logger->log(line);
+  }
+}
+
+void Table::recordWait(Philosopher& self, Duration wait) {
+  self.stats.waited(wait.count());
+  if (latency) {
+    latency->record(wait.count());
+  }
+  if (philosophers) {
+    long meals = neighbourMeals(self) - self.stats.neighbourMealsAtHungry;
+    if (meals > self.stats.maxNeighbourMeals.load(std::memory_order_relaxed)) {
+      self.stats.maxNeighbourMeals.store(meals, std::memory_order_relaxed);
+    }
+  }
+}
+
+long Table::neighbourMeals(const Philosopher& self) const {
+  int count = (int)philosophers->size();
+  const Philosopher& left = (*philosophers)[(self.id + count - 1) % count];
+  const Philosopher& right = (*philosophers)[(self.id + 1) % count];
+  long meals = left.stats.meals.load(std::memory_order_relaxed);
+  // При двух философах левый и правый сосед - один и тот же
+  if (&left != &right) {
+    meals += right.stats.meals.load(std::memory_order_relaxed);
+  }
+  return meals;
+}
+
+bool Table::pause(Duration duration) {
+  using namespace std::chrono;
+  auto deadline = steady_clock::now() + duration;
+  if (duration <= SPIN_PAUSE) {
+    // Уступаем процессор, но не засыпаем: поток остаётся готовым к работе
+    while (running && steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return running.active();
+  }
+  if (timers) {
+    return timers->sleepUntil(deadline) && running;
+  }
+  return running.waitUntil(deadline);
+}
+
+void philosopherLoop(Table& table, Philosopher& self) {
+  const Config& config = *table.config;
+  EventReporter report = [&table, &self](EventType type, int fork) {
+    table.report(self, type, fork, 0);
+  };
+
+  if (table.placement) {
+    table.placement->bind(self.id);
+  } else {
+    table.arbiter->bindThread(self.id);
+  }
+  while (table.running) {
+    // Философ размышляет
+    Duration thinkTime = self.random.time(config.think());
+    table.report(self, EventType::Think, -1, thinkTime.count());
+
+    // Проверяем флаг во время сна
+    if (!table.pause(thinkTime)) break;
+
+    // Философ голоден и берёт вилки по правилам стратегии
+    table.report(self, EventType::Hungry, -1, 0);
+    auto hungry = std::chrono::steady_clock::now();
+    if (!table.arbiter->acquire(self.id, table.running, report)) break;
+    table.recordWait(self, std::chrono::steady_clock::now() - hungry);
+
+    // Начинает есть
+    Duration eatTime = self.random.time(config.eat());
+    table.report(self, EventType::Eat, -1, eatTime.count());
+
+    // Проверяем флаг во время еды
+    table.pause(eatTime);
+
+    // Закончил есть
+    table.report(self, EventType::PutDown, -1, 0);
+    table.arbiter->release(self.id);
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef ENGINE_PHILOSOPHER_H
+#define ENGINE_PHILOSOPHER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "async_logger.h"
+#include "cancellation.h"
+#include "config.h"
+#include "event_trace.h"
+#include "events.h"
+#include "fork_arbiter.h"
+#include "latency_histogram.h"
+#include "philosopher_stats.h"
+#include "random_source.h"
+#include "thread_pinning.h"
+#include "timer_service.h"
+
+// Собственные данные философа
+struct Philosopher {
+  int id = 0;
+  RandomSource random;  // собственный генератор философа
+  PhilosopherStats stats;
+};
+
+// Общее состояние стола, разделяемое потоками философов
+struct Table {
+  const Config* config = nullptr;
+  ForkArbiter* arbiter = nullptr;
+  AsyncLogger* logger = nullptr;
+  // Флаг работы программы; его отмена прерывает все ожидания философов
+  CancellationToken running;
+  std::chrono::steady_clock::time_point start;
+  // Трасса, в которую события пишутся вместо журнала; nullptr - журнал
+  TraceWriter* trace = nullptr;
+  // Формулировки журнала (logStyleOf(*arbiter))
+  LogStyle logStyle = LogStyle::Default;
+  // Гистограммы задержек от голода до еды, nullptr - без отчёта
+  LatencyRecorder* latency = nullptr;
+  // Все философы стола, чтобы считать обеды соседей за ожидание вилок;
+  // nullptr - не считать
+  std::vector<Philosopher>* philosophers = nullptr;
+  // Процессоры потоков философов по config->pin; nullptr - потоки
+  // привязывает стратегия (ForkArbiter::bindThread) или никто
+  const ThreadPlacement* placement = nullptr;
+  // Служба таймеров для pause(); без неё поток спит на токене running
+  TimerService* timers = nullptr;
+
+  // Функция для безопасного вывода; без журнала сообщения идут в stderr
+  void print(const std::string& message);
+  // Событие философа: учитывается в его счётчиках и печатается в журнал
+  // или пишется в трассу (ForkBusy и события без журнала и трассы, как в
+  // бенчмарке, не печатаются)
+  void report(Philosopher& self, EventType type, int fork, int64_t value);
+  // Философ дождался вилок за wait после того, как проголодался
+  void recordWait(Philosopher& self, Duration wait);
+  // Сколько раз поели оба соседа философа
+  long neighbourMeals(const Philosopher& self) const;
+  // Ждёт duration. Паузы до SPIN_PAUSE выжидаются без засыпания, более
+  // длинные - в службе таймеров или на токене running. Поток просыпается в
+  // срок или сразу при отмене. Возвращает running.active().
+  bool pause(Duration duration);
+};
+
+// Паузы не длиннее этой не усыпляют поток: пробуждение через службу
+// таймеров стоит двух переключений контекста и сама пауза бы в нём утонула
+const Duration SPIN_PAUSE = std::chrono::microseconds(20);
+
+// Цикл философа: размышление, захват вилок стратегией стола, еда.
+// Возвращается, когда table.running сбрасывается.
+void philosopherLoop(Table& table, Philosopher& self);
+
+#endif  // ENGINE_PHILOSOPHER_H
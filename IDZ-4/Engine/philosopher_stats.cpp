@@ -0,0 +1,124 @@
+#include "philosopher_stats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "philosopher.h"
+
+namespace {
+
+// Больше строк в журнал не выводится, остаётся только сводка
+const size_t STATS_TABLE_LIMIT = 64;
+
+double toSeconds(int64_t nanos) { return nanos / 1e9; }
+double toMillis(int64_t nanos) { return nanos / 1e6; }
+
+// Выравнивает строку UTF-8 по правому краю поля width символов
+std::string padLeft(const std::string& text, int width) {
+  int chars = 0;
+  for (unsigned char c : text) {
+    if ((c & 0xc0) != 0x80) ++chars;
+  }
+  return std::string(std::max(0, width - chars), ' ') + text;
+}
+
+}  // namespace
+
+void PhilosopherStats::count(EventType type, int64_t value) {
+  switch (type) {
+    case EventType::Think:
+      add(thinkTime, value);
+      break;
+    case EventType::Eat:
+      add(eatTime, value);
+      break;
+    case EventType::TakeFork:
+      add(forkAttempts, 1L);
+      break;
+    case EventType::ForkBusy:
+      add(busyForks, 1L);
+      break;
+    case EventType::PutDown:
+      add(meals, 1L);
+      break;
+    default:
+      break;
+  }
+}
+
+void PhilosopherStats::waited(int64_t wait) {
+  add(hungryTime, wait);
+  if (wait > maxWait.load(std::memory_order_relaxed)) {
+    maxWait.store(wait, std::memory_order_relaxed);
+  }
+}
+
+void logStats(AsyncLogger& logger,
+              const std::vector<Philosopher>& philosophers) {
+  if (philosophers.empty()) return;
+
+  if (philosophers.size() <= STATS_TABLE_LIMIT) {
+    logger.log("\nСтатистика философов:");
+    logger.log(padLeft("Философ", 8) + padLeft("Приемы", 8) +
+               padLeft("Думал,с", 10) + padLeft("Ел,с", 10) +
+               padLeft("Голодал,с", 11) + padLeft("Макс.ожид,мс", 14) +
+               padLeft("Попытки", 10) + padLeft("Занято", 9));
+    for (const auto& philosopher : philosophers) {
+      const PhilosopherStats& s = philosopher.stats;
+      char line[160];
+      std::snprintf(line, sizeof(line),
+                    "%8d%8ld%10.2f%10.2f%11.2f%14.3f%10ld%9ld",
+                    philosopher.id, s.meals.load(),
+                    toSeconds(s.thinkTime.load()), toSeconds(s.eatTime.load()),
+                    toSeconds(s.hungryTime.load()),
+                    toMillis(s.maxWait.load()), s.forkAttempts.load(),
+                    s.busyForks.load());
+      logger.log(line);
+    }
+  }
+
+  // Сводка: разброс приемов пищи и худшее ожидание - признаки голодания
+  long minMeals = philosophers[0].stats.meals.load();
+  long maxMeals = minMeals;
+  int64_t maxWait = 0;
+  int slowest = 0;
+  long maxNeighbourMeals = 0;
+  for (const auto& philosopher : philosophers) {
+    const PhilosopherStats& s = philosopher.stats;
+    minMeals = std::min(minMeals, s.meals.load());
+    maxMeals = std::max(maxMeals, s.meals.load());
+    maxNeighbourMeals = std::max(maxNeighbourMeals, s.maxNeighbourMeals.load());
+    if (s.maxWait.load() > maxWait) {
+      maxWait = s.maxWait.load();
+      slowest = philosopher.id;
+    }
+  }
+  char line[256];
+  std::snprintf(line, sizeof(line),
+                "Приемов пищи на философа: %ld-%ld; самое долгое ожидание "
+                "вилок: %.3f мс (философ %d); соседи поели за одно "
+                "ожидание до %ld раз",
+                minMeals, maxMeals, toMillis(maxWait), slowest,
+                maxNeighbourMeals);
+  logger.log(line);
+}
+
+void writeStatsJson(std::ostream& out,
+                    const std::vector<Philosopher>& philosophers) {
+  out << "[\n";
+  for (size_t i = 0; i < philosophers.size(); ++i) {
+    const PhilosopherStats& s = philosophers[i].stats;
+    out << "  {\"philosopher\": " << philosophers[i].id
+        << ", \"meals\": " << s.meals.load()
+        << ", \"think_s\": " << toSeconds(s.thinkTime.load())
+        << ", \"eat_s\": " << toSeconds(s.eatTime.load())
+        << ", \"hungry_s\": " << toSeconds(s.hungryTime.load())
+        << ", \"max_wait_ms\": " << toMillis(s.maxWait.load())
+        << ", \"fork_attempts\": " << s.forkAttempts.load()
+        << ", \"busy_forks\": " << s.busyForks.load()
+        << ", \"max_neighbour_meals\": " << s.maxNeighbourMeals.load() << "}"
+        << (i + 1 < philosophers.size() ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
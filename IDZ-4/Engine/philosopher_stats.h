@@ -0,0 +1,51 @@
+#ifndef ENGINE_PHILOSOPHER_STATS_H
+#define ENGINE_PHILOSOPHER_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "async_logger.h"
+#include "events.h"
+
+struct Philosopher;
+
+// Счётчики философа на горячем пути. Каждый счётчик пишет только тот, кто
+// исполняет философа (поток, задача или корутина), поэтому обновление -
+// relaxed-чтение и запись без блокировок и без атомарных RMW-инструкций, а
+// читать счётчики можно из любого потока. Структура занимает собственную
+// кэш-линию, чтобы соседние философы не делили её.
+struct alignas(64) PhilosopherStats {
+  std::atomic<long> meals{0};
+  std::atomic<int64_t> thinkTime{0};   // заданное время размышлений, нс
+  std::atomic<int64_t> eatTime{0};     // заданное время еды, нс
+  std::atomic<int64_t> hungryTime{0};  // от голода до начала еды, нс
+  std::atomic<int64_t> maxWait{0};     // самое долгое ожидание вилок, нс
+  std::atomic<long> forkAttempts{0};   // попытки взять вилку
+  std::atomic<long> busyForks{0};      // попытки, заставшие вилку занятой
+  // Больше всего обедов соседей за одно ожидание вилок
+  std::atomic<long> maxNeighbourMeals{0};
+  // Обеды соседей к моменту, когда философ проголодался (рабочее поле
+  // исполняющего философа, не счётчик)
+  long neighbourMealsAtHungry = 0;
+
+  // Учитывает событие философа (value - как в Event)
+  void count(EventType type, int64_t value);
+  // Учитывает ожидание вилок длительностью wait, нс
+  void waited(int64_t wait);
+
+  template <typename T>
+  static void add(std::atomic<T>& counter, T value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+};
+
+// Таблица счётчиков в журнал (для больших столов - только сводка)
+void logStats(AsyncLogger& logger,
+              const std::vector<Philosopher>& philosophers);
+void writeStatsJson(std::ostream& out,
+                    const std::vector<Philosopher>& philosophers);
+
+#endif  // ENGINE_PHILOSOPHER_STATS_H
@@ -0,0 +1,115 @@
+#include "random_source.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Показатель формы ограниченного распределения Парето
+const double PARETO_SHAPE = 1.5;
+
+// Единицы выбора длительности фазы в наносекундах: с, мс, мкс
+const int64_t PHASE_UNITS[] = {1000000000, 1000000, 1000};
+
+uint64_t splitMix64(uint64_t& x) {
+  uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+}  // namespace
+
+bool parseDistribution(const std::string& name, Distribution& distribution) {
+  if (name == "uniform") {
+    distribution = Distribution::Uniform;
+  } else if (name == "exponential") {
+    distribution = Distribution::Exponential;
+  } else if (name == "pareto") {
+    distribution = Distribution::Pareto;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* distributionName(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::Exponential:
+      return "exponential";
+    case Distribution::Pareto:
+      return "pareto";
+    default:
+      return "uniform";
+  }
+}
+
+RandomSource::RandomSource(uint64_t masterSeed, uint64_t stream) {
+  // Номер потока перемешивается с зерном, чтобы соседние философы получили
+  // несвязанные начальные состояния
+  uint64_t x = masterSeed ^ (stream * 0xd1342543de82ef95ULL);
+  for (auto& word : state_) {
+    word = splitMix64(x);
+  }
+}
+
+uint64_t RandomSource::next() {
+  uint64_t result = rotl(state_[1] * 5, 7) * 9;
+  uint64_t t = state_[1] << 17;
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= t;
+  state_[3] = rotl(state_[3], 45);
+  return result;
+}
+
+double RandomSource::uniform01() { return (double)(next() >> 11) * 0x1.0p-53; }
+
+int64_t RandomSource::time(int64_t minVal, int64_t maxVal,
+                           Distribution distribution) {
+  if (maxVal <= minVal) {
+    return minVal;
+  }
+
+  double lo = minVal;
+  double hi = maxVal;
+  double u = uniform01();
+  double value;
+  switch (distribution) {
+    case Distribution::Exponential: {
+      // Обратная функция усечённого на [lo, hi] экспоненциального
+      // распределения со средним (hi - lo) / 2 от начала отрезка
+      double mean = (hi - lo) / 2;
+      double tail = 1 - std::exp(-(hi - lo) / mean);
+      value = lo - mean * std::log(1 - u * tail);
+      break;
+    }
+    case Distribution::Pareto: {
+      // Обратная функция ограниченного распределения Парето на [lo, hi]
+      double la = std::pow(lo, PARETO_SHAPE);
+      double ha = std::pow(hi, PARETO_SHAPE);
+      value = std::pow((ha - u * (ha - la)) / (ha * la), -1 / PARETO_SHAPE);
+      break;
+    }
+    default:
+      return minVal + (int64_t)(next() % (uint64_t)(maxVal - minVal + 1));
+  }
+  return std::clamp((int64_t)std::llround(value), minVal, maxVal);
+}
+
+Duration RandomSource::time(const PhaseTime& phase) {
+  int64_t unit = 1;
+  for (int64_t candidate : PHASE_UNITS) {
+    if (phase.min.count() % candidate == 0 &&
+        phase.max.count() % candidate == 0) {
+      unit = candidate;
+      break;
+    }
+  }
+  return Duration(unit * time(phase.min.count() / unit,
+                              phase.max.count() / unit, phase.distribution));
+}
@@ -0,0 +1,51 @@
+#ifndef ENGINE_RANDOM_SOURCE_H
+#define ENGINE_RANDOM_SOURCE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Распределение случайной длительности фазы на отрезке [min, max]
+enum class Distribution {
+  Uniform,      // равномерное
+  Exponential,  // экспоненциальное, усечённое по max
+  Pareto,       // ограниченное Парето с тяжёлым хвостом
+};
+
+// Длительности фаз и симуляции
+using Duration = std::chrono::nanoseconds;
+
+// Случайная длительность фазы: границы отрезка и распределение
+struct PhaseTime {
+  Duration min;
+  Duration max;
+  Distribution distribution;
+};
+
+bool parseDistribution(const std::string& name, Distribution& distribution);
+const char* distributionName(Distribution distribution);
+
+// Генератор случайных чисел отдельного философа (xoshiro256**).
+// Каждый философ получает собственный поток чисел, выведенный из общего
+// зерна и своего номера, поэтому генераторы не делят состояние между
+// потоками, а запуск с тем же --seed воспроизводит те же длительности.
+class RandomSource {
+ public:
+  RandomSource() : RandomSource(0, 0) {}
+  RandomSource(uint64_t masterSeed, uint64_t stream);
+
+  uint64_t next();
+  // Равномерное число из [0, 1)
+  double uniform01();
+  // Случайное целое из [minVal, maxVal] с заданным распределением
+  int64_t time(int64_t minVal, int64_t maxVal, Distribution distribution);
+  // Случайная длительность фазы. Выбирается целое число самых крупных
+  // единиц (с, мс, мкс, нс), в которых обе границы целые, поэтому фазы в
+  // целых секундах остаются целыми секундами.
+  Duration time(const PhaseTime& phase);
+
+ private:
+  uint64_t state_[4];
+};
+
+#endif  // ENGINE_RANDOM_SOURCE_H
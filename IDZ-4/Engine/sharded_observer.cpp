@@ -0,0 +1,95 @@
+#include "sharded_observer.h"
+
+ShardedForkObserver::ShardedForkObserver(int numPhilosophers)
+    : forks_(numPhilosophers),
+      seats_(numPhilosophers),
+      numPhilosophers_(numPhilosophers) {}
+
+bool ShardedForkObserver::tryTake(int fork) {
+  std::lock_guard<std::mutex> lock(forks_[fork].mutex);
+  if (!forks_[fork].available) {
+    return false;
+  }
+  forks_[fork].available = false;
+  return true;
+}
+
+void ShardedForkObserver::putDown(int fork) {
+  std::lock_guard<std::mutex> lock(forks_[fork].mutex);
+  forks_[fork].available = true;
+}
+
+void ShardedForkObserver::notify(int philosopher) {
+  SeatSlot& seat = seats_[philosopher];
+  // Захват мьютекса места не даёт уведомлению проскочить между проверкой
+  // вилок в takeForks и засыпанием
+  { std::lock_guard<std::mutex> lock(seat.mutex); }
+  seat.forkReleased.notify_one();
+}
+
+bool ShardedForkObserver::tryTakeLeftFork(int philosopher) {
+  return tryTake(philosopher);
+}
+
+bool ShardedForkObserver::tryTakeRightFork(int philosopher) {
+  if (!tryTake((philosopher + 1) % numPhilosophers_)) {
+    return false;
+  }
+  seats_[philosopher].eating.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void ShardedForkObserver::putDownLeftFork(int philosopher) {
+  putDown(philosopher);
+  notify((philosopher + numPhilosophers_ - 1) % numPhilosophers_);
+}
+
+void ShardedForkObserver::putDownForks(int philosopher) {
+  putDown(philosopher);                           // левая вилка
+  putDown((philosopher + 1) % numPhilosophers_);  // правая вилка
+  seats_[philosopher].eating.store(false, std::memory_order_relaxed);
+
+  // Уведомляем соседей
+  notify((philosopher + numPhilosophers_ - 1) % numPhilosophers_);
+  notify((philosopher + 1) % numPhilosophers_);
+}
+
+bool ShardedForkObserver::tryTakeBoth(int philosopher) {
+  ForkSlot& left = forks_[philosopher];
+  ForkSlot& right = forks_[(philosopher + 1) % numPhilosophers_];
+  std::lock(left.mutex, right.mutex);
+  std::lock_guard<std::mutex> leftLock(left.mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> rightLock(right.mutex, std::adopt_lock);
+  if (!left.available || !right.available) {
+    return false;
+  }
+  left.available = false;
+  right.available = false;
+  return true;
+}
+
+bool ShardedForkObserver::takeForks(int philosopher,
+                                    const CancellationToken& running,
+                                    const EventReporter& report) {
+  SeatSlot& seat = seats_[philosopher];
+  std::unique_lock<std::mutex> lock(seat.mutex);
+  bool taken = false;
+  seat.forkReleased.wait(lock, [&] {
+    taken = running && tryTakeBoth(philosopher);
+    if (!taken && running) {
+      report(EventType::ForkBusy, -1);
+    }
+    return taken || !running;
+  });
+  if (!taken) {
+    return false;
+  }
+  seat.eating.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void ShardedForkObserver::cancel() {
+  for (int philosopher = 0; philosopher < numPhilosophers_; ++philosopher) {
+    notify(philosopher);
+  }
+}
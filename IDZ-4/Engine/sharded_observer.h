@@ -0,0 +1,57 @@
+#ifndef ENGINE_SHARDED_OBSERVER_H
+#define ENGINE_SHARDED_OBSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "cancellation.h"
+#include "fork_arbiter.h"
+
+// Наблюдатель с тем же интерфейсом, что ForkObserver, но вместо CAS над
+// атомарными слотами у каждой вилки и у каждого места за столом свой
+// мьютекс, а слоты выровнены по кэш-линии, чтобы соседние философы не делили
+// линию. Операции над вилкой затрагивают только её и соседей.
+class ShardedForkObserver {
+ public:
+  explicit ShardedForkObserver(int numPhilosophers);
+
+  bool tryTakeLeftFork(int philosopher);
+  bool tryTakeRightFork(int philosopher);
+  // Возвращает только левую вилку, если правую взять не успели
+  void putDownLeftFork(int philosopher);
+  void putDownForks(int philosopher);
+  // Берёт обе вилки сразу или ждёт, пока обе освободятся; каждая неудачная
+  // попытка отмечается событием ForkBusy. Возвращает false, если running
+  // сброшен; тогда вилки не взяты.
+  bool takeForks(int philosopher, const CancellationToken& running,
+                 const EventReporter& report);
+  // Будит всех ждущих в takeForks() после отмены running
+  void cancel();
+
+ private:
+  struct alignas(64) ForkSlot {
+    std::mutex mutex;
+    bool available = true;
+  };
+
+  struct alignas(64) SeatSlot {
+    std::mutex mutex;
+    std::condition_variable forkReleased;
+    // Пишет только сам философ, поэтому отдельный мьютекс не нужен
+    std::atomic<bool> eating{false};
+  };
+
+  bool tryTake(int fork);
+  // Занимает обе вилки философа, если обе свободны
+  bool tryTakeBoth(int philosopher);
+  void putDown(int fork);
+  void notify(int philosopher);
+
+  std::vector<ForkSlot> forks_;
+  std::vector<SeatSlot> seats_;
+  int numPhilosophers_;
+};
+
+#endif  // ENGINE_SHARDED_OBSERVER_H
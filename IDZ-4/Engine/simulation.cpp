@@ -0,0 +1,288 @@
+#include "simulation.h"
+
+#include <pthread.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "coro_table.h"
+#include "event_trace.h"
+#include "latency_histogram.h"
+#include "task_table.h"
+#include "virtual_time.h"
+
+namespace {
+
+// Размер стека потока философа: по умолчанию 8 МБ, что не даёт
+// запустить десятки тысяч потоков
+const size_t PHILOSOPHER_STACK_SIZE = 64 * 1024;
+
+struct ThreadArgs {
+  Table* table;
+  Philosopher* self;
+};
+
+void* philosopherThread(void* arg) {
+  auto* args = (ThreadArgs*)arg;
+  philosopherLoop(*args->table, *args->self);
+  return nullptr;
+}
+
+void printHeader(const Config& config, AsyncLogger& logger) {
+  logger.log("\nНачальная конфигурация:");
+  logger.log("Стратегия: " + config.strategy +
+             (config.strategy == "aging"
+                  ? " (младшие соседи обходят ждущего не больше " +
+                        std::to_string(config.maxBypass) + " раз)"
+                  : ""));
+  logger.log("Время размышления: " +
+             formatDurationRange(config.minThink, config.maxThink));
+  logger.log("Время приема пищи: " +
+             formatDurationRange(config.minEat, config.maxEat));
+  logger.log("Количество философов: " +
+             std::to_string(config.numPhilosophers));
+  logger.log("Распределения: размышление - " +
+             std::string(distributionName(config.thinkDistribution)) +
+             ", прием пищи - " +
+             std::string(distributionName(config.eatDistribution)));
+  logger.log("Зерно генератора: " + std::to_string(config.seed));
+  if (config.executor != Executor::Threads) {
+    logger.log("Исполнение: " + std::string(executorName(config.executor)) +
+               (config.workers > 0
+                    ? " на " + std::to_string(config.workers) +
+                          " рабочих потоках"
+                    : ", рабочий поток на процессор"));
+  } else if (config.pin != PinPolicy::None) {
+    logger.log("Привязка потоков к процессорам: " +
+               std::string(pinPolicyName(config.pin)));
+  }
+  logger.log("Время симуляции: " + formatDuration(config.simulationTime) +
+             "\n");
+}
+
+// Проигрывает симуляцию в виртуальном времени: тот же протокол захвата вилок,
+// но без потоков и sleep
+bool runVirtualTime(const Config& config, const ForkArbiter& arbiter,
+                    AsyncLogger& logger, TraceWriter* trace,
+                    long& totalMeals) {
+  LogStyle style = logStyleOf(arbiter);
+  VirtualProtocol protocol{};
+  if (!arbiter.virtualProtocol(protocol)) {
+    logger.log("Стратегия " + config.strategy +
+               " не поддерживает режим виртуального времени.");
+    return false;
+  }
+
+  VirtualTimeSimulation simulation(config.numPhilosophers, protocol,
+                                   config.think(), config.eat(), config.seed);
+  // Задержка считается по модельному времени событий Hungry и Eat
+  std::vector<int64_t> hungrySince(config.numPhilosophers);
+  LatencyHistogram latency;
+  bool finished = simulation.run(
+      config.simulationTime, [&](const Event& event) {
+        if (config.latencyReport) {
+          if (event.type == EventType::Hungry) {
+            hungrySince[event.philosopher] = event.time;
+          } else if (event.type == EventType::Eat) {
+            latency.record((event.time - hungrySince[event.philosopher]) *
+                           1000);
+          }
+        }
+        if (trace) {
+          trace->write(event);
+          return;
+        }
+        std::string line = formatEvent(event, style);
+        if (!line.empty()) {
+          logger.log(line);
+        }
+      });
+
+  if (!finished) {
+    logger.log("\nВсе философы ждут вилок: симуляция зашла в тупик.");
+  }
+  logger.log("\nВиртуальное время работы программы истекло.");
+  totalMeals = simulation.totalMeals();
+  if (config.latencyReport) {
+    logger.log(formatLatencyReport(latency));
+  }
+  return true;
+}
+
+}  // namespace
+
+void launchPthreads(Table& table, std::vector<Philosopher>& philosophers) {
+  std::vector<pthread_t> threads;
+  threads.reserve(philosophers.size());
+  std::vector<ThreadArgs> args(philosophers.size());
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, PHILOSOPHER_STACK_SIZE);
+
+  for (size_t i = 0; i < philosophers.size(); i++) {
+    args[i] = {&table, &philosophers[i]};
+    pthread_t thread;
+    if (pthread_create(&thread, &attr, philosopherThread, &args[i]) != 0) {
+      table.print("Ошибка: не удалось создать поток философа " +
+                  std::to_string(i));
+      table.running.cancel();
+      break;
+    }
+    threads.push_back(thread);
+  }
+  pthread_attr_destroy(&attr);
+
+  bool timedOut = false;
+  if (table.running) {
+    waitForTimeout(table);
+    timedOut = true;
+  }
+  auto cancelled = std::chrono::steady_clock::now();
+
+  // Ожидание завершения всех потоков
+  for (auto& thread : threads) {
+    pthread_join(thread, nullptr);
+  }
+  if (timedOut && table.logger) {
+    auto joined = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - cancelled);
+    table.print("Все потоки завершены за " + std::to_string(joined.count()) +
+                " мс.");
+  }
+}
+
+void launchPhilosophers(Table& table, std::vector<Philosopher>& philosophers,
+                        const ThreadLauncher& launch) {
+  switch (table.config->executor) {
+    case Executor::Threads: {
+      // Потоки спят в pause() на общей службе таймеров. Отмена running
+      // будит и спящих, и ждущих вилок.
+      TimerService timers;
+      timers.start();
+      table.timers = &timers;
+      std::unique_ptr<ThreadPlacement> placement;
+      if (table.config->pin != PinPolicy::None) {
+        placement = std::make_unique<ThreadPlacement>(
+            table.config->pin, table.config->numPhilosophers);
+        table.placement = placement.get();
+      }
+      table.running.subscribe([&timers] { timers.stop(); });
+      table.running.subscribe([&table] { table.arbiter->cancel(); });
+      launch(table, philosophers);
+      table.timers = nullptr;
+      table.placement = nullptr;
+      break;
+    }
+    case Executor::Tasks:
+      launchTasks(table, philosophers);
+      break;
+    case Executor::Coroutines:
+      launchCoroutines(table, philosophers);
+      break;
+  }
+}
+
+void waitForTimeout(Table& table) {
+  table.pause(table.config->simulationTime);
+  // Сигнал для завершения потоков
+  table.running.cancel();
+  if (table.logger) {
+    table.print(
+        "\nВремя работы программы истекло. Ожидание завершения потоков...");
+  }
+}
+
+int runSimulation(const Config& config, const ThreadLauncher& launch) {
+  std::unique_ptr<ForkArbiter> arbiter =
+      makeArbiter(config.strategy, config.numPhilosophers,
+                  config.maxBypass);
+  if (!arbiter) {
+    std::cerr << "Неизвестная стратегия: " << config.strategy << "\n";
+    return 1;
+  }
+
+  AsyncLogger logger;
+  logger.setTimestamps(config.logTimestamps);
+  if (!config.outputPath.empty() && !logger.openFile(config.outputPath)) {
+    std::cerr << "Ошибка открытия выходного файла\n";
+    return 1;
+  }
+  TraceWriter trace;
+  if (!config.tracePath.empty() &&
+      !trace.open(config.tracePath, logStyleOf(*arbiter))) {
+    std::cerr << "Ошибка открытия файла трассы\n";
+    return 1;
+  }
+  TraceWriter* tracePtr = config.tracePath.empty() ? nullptr : &trace;
+
+  // Запускаем поток вывода журнала
+  std::cout.flush();
+  logger.start();
+  printHeader(config, logger);
+
+  long totalMeals = 0;
+  VirtualProtocol protocol{};
+  if (config.virtualTime) {
+    if (!runVirtualTime(config, *arbiter, logger, tracePtr, totalMeals)) {
+      logger.stop();
+      return 1;
+    }
+  } else if (config.executor != Executor::Threads &&
+             !arbiter->virtualProtocol(protocol)) {
+    logger.log("Стратегия " + config.strategy +
+               " не поддерживает планировщик M:N.");
+    logger.stop();
+    return 1;
+  } else {
+    Table table;
+    table.config = &config;
+    table.arbiter = arbiter.get();
+    table.logger = &logger;
+    table.trace = tracePtr;
+    table.logStyle = logStyleOf(*arbiter);
+    table.start = std::chrono::steady_clock::now();
+    LatencyRecorder latency;
+    if (config.latencyReport) {
+      table.latency = &latency;
+    }
+
+    std::vector<Philosopher> philosophers(config.numPhilosophers);
+    for (int i = 0; i < config.numPhilosophers; i++) {
+      philosophers[i].id = i;
+      philosophers[i].random = RandomSource(config.seed, i);
+    }
+
+    table.philosophers = &philosophers;
+    launchPhilosophers(table, philosophers, launch);
+
+    for (const auto& philosopher : philosophers) {
+      totalMeals += philosopher.stats.meals.load();
+    }
+    logStats(logger, philosophers);
+    if (config.latencyReport) {
+      logger.log(formatLatencyReport(latency.merged()));
+    }
+    if (!config.statsPath.empty()) {
+      std::ofstream stats(config.statsPath);
+      writeStatsJson(stats, philosophers);
+      if (!stats) {
+        logger.log("Ошибка записи " + config.statsPath);
+      }
+    }
+  }
+
+  if (tracePtr) {
+    logger.log(trace.close() ? "События записаны в трассу " + config.tracePath
+                             : "Ошибка записи трассы " + config.tracePath);
+  }
+
+  // Пропускная способность: суммарное число приемов пищи за время работы
+  std::chrono::duration<double> seconds = config.simulationTime;
+  logger.log("Всего приемов пищи: " + std::to_string(totalMeals) + " (" +
+             std::to_string(totalMeals / seconds.count()) + " в секунду)");
+  logger.log("Программа завершена.");
+  logger.stop();
+  return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef ENGINE_SIMULATION_H
+#define ENGINE_SIMULATION_H
+
+#include <functional>
+#include <vector>
+
+#include "config.h"
+#include "philosopher.h"
+
+// Запускает циклы всех философов, ждёт окончания симуляции и завершения
+// потоков. Позволяет исполнять философов не только потоками pthread
+// (например, потоками OpenMP в Solution_5).
+using ThreadLauncher =
+    std::function<void(Table& table, std::vector<Philosopher>& philosophers)>;
+
+// Каждый философ - отдельный поток pthread с уменьшенным стеком
+void launchPthreads(Table& table, std::vector<Philosopher>& philosophers);
+
+// Исполняет философов способом config.executor: потоками через launch или
+// на планировщике M:N
+void launchPhilosophers(Table& table, std::vector<Philosopher>& philosophers,
+                        const ThreadLauncher& launch);
+
+// Ждёт config.simulationTime и даёт философам сигнал завершаться
+void waitForTimeout(Table& table);
+
+// Печатает начальную конфигурацию, проводит симуляцию стратегией
+// config.strategy (в реальном или виртуальном времени) и выводит итоги.
+// Возвращает код завершения программы.
+int runSimulation(const Config& config,
+                  const ThreadLauncher& launch = launchPthreads);
+
+#endif  // ENGINE_SIMULATION_H
@@ -0,0 +1,81 @@
+#include "stopper_arbiter.h"
+
+template <typename ForkLock>
+StopperArbiter<ForkLock>::StopperArbiter(int numPhilosophers, const char* name)
+    : ForkArbiter(numPhilosophers), forks_(numPhilosophers), name_(name) {
+  sem_init(&stopper_, 0, numPhilosophers - 1);
+}
+
+template <typename ForkLock>
+StopperArbiter<ForkLock>::~StopperArbiter() {
+  sem_destroy(&stopper_);
+}
+
+template <typename ForkLock>
+bool StopperArbiter<ForkLock>::acquire(int philosopher,
+                                       const CancellationToken& running,
+                                       const EventReporter& report) {
+  int left = leftFork(philosopher);
+  int right = rightFork(philosopher);
+
+  // Запрос разрешения у блокировщика
+  report(EventType::WaitPermission, -1);
+  sem_wait(&stopper_);
+  if (!running) {
+    sem_post(&stopper_);
+    return false;
+  }
+
+  // Берёт левую вилку
+  if (!take(left, report)) {
+    sem_post(&stopper_);
+    return false;
+  }
+
+  // Берёт правую вилку
+  if (!take(right, report)) {
+    forks_[left].unlock();
+    sem_post(&stopper_);
+    return false;
+  }
+  return true;
+}
+
+template <typename ForkLock>
+bool StopperArbiter<ForkLock>::take(int fork, const EventReporter& report) {
+  report(EventType::TakeFork, fork);
+  if (forks_[fork].tryLock()) {
+    return true;
+  }
+  report(EventType::ForkBusy, fork);
+  return forks_[fork].lock();
+}
+
+template <typename ForkLock>
+void StopperArbiter<ForkLock>::release(int philosopher) {
+  forks_[rightFork(philosopher)].unlock();
+  forks_[leftFork(philosopher)].unlock();
+
+  // Освобождает блокировщик
+  sem_post(&stopper_);
+}
+
+// Ждущий блокировщика, проснувшись при отменённом running, возвращает
+// разрешение и тем будит следующего
+template <typename ForkLock>
+void StopperArbiter<ForkLock>::cancel() {
+  for (auto& fork : forks_) {
+    fork.cancel();
+  }
+  sem_post(&stopper_);
+}
+
+template <typename ForkLock>
+bool StopperArbiter<ForkLock>::virtualProtocol(
+    VirtualProtocol& protocol) const {
+  protocol = {true, false, false, false};
+  return true;
+}
+
+template class StopperArbiter<SemaphoreForkLock>;
+template class StopperArbiter<FutexForkLock>;
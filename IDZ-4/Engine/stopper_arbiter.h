@@ -0,0 +1,38 @@
+#ifndef ENGINE_STOPPER_ARBITER_H
+#define ENGINE_STOPPER_ARBITER_H
+
+#include <semaphore.h>
+
+#include <vector>
+
+#include "fork_arbiter.h"
+#include "fork_lock.h"
+
+// Семафоры на вилках и семафор-блокировщик на (N - 1) разрешений
+// (Solution_1..3): одновременно за вилки борются не больше N - 1 философов,
+// поэтому круговое ожидание невозможно. ForkLock - тип вилки:
+// SemaphoreForkLock (sem_t) или FutexForkLock.
+template <typename ForkLock>
+class StopperArbiter : public ForkArbiter {
+ public:
+  StopperArbiter(int numPhilosophers, const char* name);
+  ~StopperArbiter() override;
+
+  const char* name() const override { return name_; }
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override;
+  void release(int philosopher) override;
+  void cancel() override;
+  bool virtualProtocol(VirtualProtocol& protocol) const override;
+
+ private:
+  // Берёт вилку; занятая вилка отмечается событием ForkBusy. Возвращает
+  // false при отмене.
+  bool take(int fork, const EventReporter& report);
+
+  std::vector<ForkLock> forks_;
+  sem_t stopper_;
+  const char* name_;
+};
+
+#endif  // ENGINE_STOPPER_ARBITER_H
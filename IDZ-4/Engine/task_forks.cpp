@@ -0,0 +1,99 @@
+#include "task_forks.h"
+
+#include <algorithm>
+
+bool TaskSemaphore::tryAcquire(Task* waiter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ > 0) {
+    --count_;
+    return true;
+  }
+  waiter->nextWaiter = nullptr;
+  if (tail_) {
+    tail_->nextWaiter = waiter;
+  } else {
+    head_ = waiter;
+  }
+  tail_ = waiter;
+  return false;
+}
+
+Task* TaskSemaphore::release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!head_) {
+    ++count_;
+    return nullptr;
+  }
+  Task* waiter = head_;
+  head_ = waiter->nextWaiter;
+  if (!head_) {
+    tail_ = nullptr;
+  }
+  return waiter;
+}
+
+TaskForkMonitor::TaskForkMonitor(int numPhilosophers)
+    : numPhilosophers_(numPhilosophers),
+      forkFree_(numPhilosophers, 1),
+      waiters_(numPhilosophers, nullptr) {}
+
+bool TaskForkMonitor::takeBoth(int philosopher) {
+  int left = philosopher;
+  int right = (philosopher + 1) % numPhilosophers_;
+  if (!forkFree_[left] || !forkFree_[right]) {
+    return false;
+  }
+  forkFree_[left] = 0;
+  forkFree_[right] = 0;
+  return true;
+}
+
+bool TaskForkMonitor::tryTakeBoth(int philosopher, Task* waiter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (takeBoth(philosopher)) {
+    return true;
+  }
+  waiters_[philosopher] = waiter;
+  return false;
+}
+
+int TaskForkMonitor::putBoth(int philosopher, Task* woken[2]) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  forkFree_[philosopher] = 1;
+  forkFree_[(philosopher + 1) % numPhilosophers_] = 1;
+
+  int count = 0;
+  int neighbours[] = {(philosopher + numPhilosophers_ - 1) % numPhilosophers_,
+                      (philosopher + 1) % numPhilosophers_};
+  for (int neighbour : neighbours) {
+    if (waiters_[neighbour] && takeBoth(neighbour)) {
+      woken[count++] = waiters_[neighbour];
+      waiters_[neighbour] = nullptr;
+    }
+  }
+  return count;
+}
+
+TaskForkTable::TaskForkTable(int numPhilosophers, VirtualProtocol protocol)
+    : protocol(protocol),
+      stopper(numPhilosophers - 1),
+      forks(numPhilosophers),
+      monitor(numPhilosophers),
+      first(numPhilosophers),
+      second(numPhilosophers) {
+  for (int i = 0; i < numPhilosophers; ++i) {
+    forks[i].reset(1);
+    int left = i;
+    int right = (i + 1) % numPhilosophers;
+    if (protocol.orderedForks) {
+      first[i] = std::min(left, right);
+      second[i] = std::max(left, right);
+    } else if (protocol.oddRightFirst && i % 2 == 1) {
+      first[i] = right;
+      second[i] = left;
+    } else {
+      first[i] = left;
+      second[i] = right;
+    }
+  }
+}
@@ -0,0 +1,70 @@
+#ifndef ENGINE_TASK_FORKS_H
+#define ENGINE_TASK_FORKS_H
+
+#include <mutex>
+#include <vector>
+
+#include "task_scheduler.h"
+#include "virtual_time.h"
+
+// Счётный семафор для задач с очередью ожидающих (FIFO, как у sem_wait).
+// Вместо блокировки потока задача остаётся в очереди, а release() передаёт
+// разрешение первому ожидающему.
+class TaskSemaphore {
+ public:
+  explicit TaskSemaphore(int count = 0) : count_(count) {}
+
+  void reset(int count) { count_ = count; }
+
+  // Берёт разрешение или ставит waiter в очередь и возвращает false
+  bool tryAcquire(Task* waiter);
+  // Возвращает разрешение. Если его ждёт задача, разрешение достаётся ей, и
+  // вызывающий должен сделать её готовой; иначе возвращает nullptr.
+  Task* release();
+
+ private:
+  std::mutex mutex_;
+  int count_;
+  // Очередь ожидающих, связанная через Task::nextWaiter
+  Task* head_ = nullptr;
+  Task* tail_ = nullptr;
+};
+
+// Вилки протокола bothForks для задач: философ берёт обе вилки разом под
+// общим монитором (как MonitorArbiter), а если одна занята - ждёт, пока
+// сосед не положит свои вилки
+class TaskForkMonitor {
+ public:
+  explicit TaskForkMonitor(int numPhilosophers);
+
+  // Берёт обе вилки философа или запоминает waiter и возвращает false
+  bool tryTakeBoth(int philosopher, Task* waiter);
+  // Кладёт вилки философа и отдаёт их ждущим соседям, у которых свободна и
+  // вторая вилка. Возвращает число таких соседей (до двух), их задачи
+  // записываются в woken; вызывающий должен сделать их готовыми.
+  int putBoth(int philosopher, Task* woken[2]);
+
+ private:
+  bool takeBoth(int philosopher);
+
+  int numPhilosophers_;
+  std::mutex mutex_;
+  std::vector<char> forkFree_;
+  std::vector<Task*> waiters_;  // задача ждущего философа или nullptr
+};
+
+// Вилки и блокировщик стола для задач, устроенные по протоколу стратегии
+// (ForkArbiter::virtualProtocol)
+struct TaskForkTable {
+  TaskForkTable(int numPhilosophers, VirtualProtocol protocol);
+
+  VirtualProtocol protocol;
+  TaskSemaphore stopper;
+  std::vector<TaskSemaphore> forks;
+  TaskForkMonitor monitor;  // используется только при protocol.bothForks
+  // Номера вилок философа в порядке захвата
+  std::vector<int> first;
+  std::vector<int> second;
+};
+
+#endif  // ENGINE_TASK_FORKS_H
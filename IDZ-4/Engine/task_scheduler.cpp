@@ -0,0 +1,172 @@
+#include "task_scheduler.h"
+
+#include <algorithm>
+
+#include "timer_service.h"
+
+namespace {
+
+// Планировщик и номер рабочего потока, которые исполняют текущий поток
+thread_local const TaskScheduler* currentScheduler = nullptr;
+thread_local int currentWorker = -1;
+
+}  // namespace
+
+TaskScheduler::TaskScheduler(int workers) {
+  if (workers <= 0) {
+    workers = (int)std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(workers);
+  for (int i = 0; i < workers; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_.back()->index = i;
+  }
+}
+
+TaskScheduler::~TaskScheduler() { stop(); }
+
+void TaskScheduler::start() {
+  running_ = true;
+  for (auto& worker : workers_) {
+    Worker* self = worker.get();
+    self->thread = std::thread([this, self] { workerLoop(*self); });
+  }
+}
+
+void TaskScheduler::stop() {
+  if (!running_.exchange(false)) return;
+  {
+    std::lock_guard<std::mutex> lock(idleMutex_);
+    idleCond_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+TaskScheduler::Worker& TaskScheduler::targetWorker() {
+  if (currentScheduler == this) {
+    return *workers_[currentWorker];
+  }
+  unsigned index = nextWorker_.fetch_add(1, std::memory_order_relaxed);
+  return *workers_[index % workers_.size()];
+}
+
+void TaskScheduler::schedule(Task* task) { push(targetWorker(), task); }
+
+void TaskScheduler::scheduleAt(Task* task, Clock::time_point when) {
+  Worker& worker = targetWorker();
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.timers.add(task, when);
+  }
+  // Свой поток увидит таймер в начале следующего шага, а чужой мог уже
+  // заснуть до более позднего срока
+  if (currentScheduler != this) {
+    wakeIdle(true);
+  }
+}
+
+void TaskScheduler::push(Worker& worker, Task* task) {
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.ready.push_back(task);
+  }
+  queued_.fetch_add(1);
+  wakeIdle(false);
+}
+
+void TaskScheduler::wakeIdle(bool all) {
+  if (idle_.load() == 0) return;
+  std::lock_guard<std::mutex> lock(idleMutex_);
+  if (all) {
+    idleCond_.notify_all();
+  } else {
+    idleCond_.notify_one();
+  }
+}
+
+void TaskScheduler::fireTimers(Worker& self) {
+  long fired = 0;
+  {
+    std::lock_guard<std::mutex> lock(self.mutex);
+    if (!self.timers.empty()) {
+      self.expired.clear();
+      self.timers.advance(Clock::now(), self.expired);
+      for (TimerWheel::Entry* entry : self.expired) {
+        self.ready.push_back(static_cast<Task*>(entry));
+      }
+      fired = (long)self.expired.size();
+    }
+  }
+  if (fired > 0) {
+    queued_.fetch_add(fired);
+    // Одну задачу исполнит сам поток, остальные могут украсть соседи
+    if (fired > 1) {
+      wakeIdle(false);
+    }
+  }
+}
+
+Task* TaskScheduler::popLocal(Worker& self) {
+  std::lock_guard<std::mutex> lock(self.mutex);
+  if (self.ready.empty()) return nullptr;
+  Task* task = self.ready.front();
+  self.ready.pop_front();
+  queued_.fetch_sub(1);
+  return task;
+}
+
+Task* TaskScheduler::steal(Worker& self) {
+  int count = (int)workers_.size();
+  for (int i = 1; i < count; ++i) {
+    Worker& victim = *workers_[(self.index + i) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.ready.empty()) continue;
+    Task* task = victim.ready.back();
+    victim.ready.pop_back();
+    queued_.fetch_sub(1);
+    return task;
+  }
+  return nullptr;
+}
+
+void TaskScheduler::workerLoop(Worker& self) {
+  currentScheduler = this;
+  currentWorker = self.index;
+  usePreciseTimers();
+
+  while (running_) {
+    fireTimers(self);
+    Task* task = popLocal(self);
+    if (!task) {
+      task = steal(self);
+    }
+    if (task) {
+      task->run();
+      continue;
+    }
+
+    // Работы нет: спим до ближайшего таймера. Срок перечитывается под
+    // idleMutex_, поэтому таймер, добавленный извне перед wakeIdle(), не
+    // теряется.
+    std::unique_lock<std::mutex> idleLock(idleMutex_);
+    idle_.fetch_add(1);
+    Clock::time_point next;
+    {
+      std::lock_guard<std::mutex> lock(self.mutex);
+      next = self.timers.nextDeadline();
+    }
+    if (running_ && queued_.load() == 0) {
+      if (next == Clock::time_point::max()) {
+        idleCond_.wait(idleLock);
+      } else {
+        idleCond_.wait_until(idleLock, next);
+      }
+    }
+    idle_.fetch_sub(1);
+  }
+
+  currentScheduler = nullptr;
+  currentWorker = -1;
+}
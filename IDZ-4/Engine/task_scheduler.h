@@ -0,0 +1,96 @@
+#ifndef ENGINE_TASK_SCHEDULER_H
+#define ENGINE_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "timer_wheel.h"
+
+// Задача планировщика - возобновляемый конечный автомат. run() выполняет
+// один шаг и возвращается, не блокируя поток: чтобы продолжить позже, задача
+// сама ставит себя в очередь (schedule/scheduleAt) или её ставит туда тот,
+// кто освободит нужный ей ресурс. После этого задача не должна обращаться к
+// своим полям: её уже может исполнять другой рабочий поток. Запись таймера
+// встроена в задачу: у задачи не больше одного таймера сразу.
+class Task : public TimerWheel::Entry {
+ public:
+  virtual ~Task() = default;
+  virtual void run() = 0;
+
+  // Ссылка для очередей ожидания (TaskSemaphore): задача ждёт не больше
+  // одного ресурса сразу, поэтому очереди обходятся без выделения памяти
+  Task* nextWaiter = nullptr;
+};
+
+// Планировщик M:N: задачи исполняются фиксированным набором рабочих потоков.
+// У каждого потока своя очередь готовых задач и своё колесо таймеров. Владелец
+// берёт задачи с головы очереди, в порядке пробуждения: иначе свежие
+// пробуждения (пачка сработавших таймеров, соседи, отдавшие вилки) могли бы
+// бесконечно откладывать давно готовую задачу. Простаивающий поток крадёт с
+// хвоста чужой очереди: владелец дошёл бы до этой задачи последним, и к тому
+// времени её данные всё равно ушли бы из его кэша. Поток без работы спит до
+// ближайшего своего таймера или до появления новых задач.
+class TaskScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // workers == 0 - по потоку на процессор
+  explicit TaskScheduler(int workers = 0);
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  int workers() const { return (int)workers_.size(); }
+
+  void start();
+  // Останавливает рабочие потоки после текущих шагов задач; задачи, которые
+  // ещё ждут в очередях, не исполняются
+  void stop();
+
+  // Делает задачу готовой к исполнению. Из рабочего потока задача попадает
+  // в его очередь, извне - в очереди потоков по кругу.
+  void schedule(Task* task);
+  // Делает задачу готовой к моменту when (с точностью до такта колеса,
+  // TimerWheel::DEFAULT_RESOLUTION)
+  void scheduleAt(Task* task, Clock::time_point when);
+
+ private:
+  struct alignas(64) Worker {
+    int index = 0;
+    std::mutex mutex;
+    std::deque<Task*> ready;
+    TimerWheel timers;
+    std::vector<TimerWheel::Entry*> expired;  // буфер для fireTimers()
+    std::thread thread;
+  };
+
+  void workerLoop(Worker& self);
+  Worker& targetWorker();
+  void push(Worker& worker, Task* task);
+  // Переносит сработавшие таймеры в очередь готовых
+  void fireTimers(Worker& self);
+  Task* popLocal(Worker& self);
+  Task* steal(Worker& self);
+  void wakeIdle(bool all);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<bool> running_{false};
+  std::atomic<unsigned> nextWorker_{0};
+  // Число готовых задач во всех очередях и число спящих потоков: поток
+  // засыпает, только увидев queued_ == 0 после увеличения idle_, а schedule()
+  // будит, только увидев idle_ > 0 после увеличения queued_
+  std::atomic<long> queued_{0};
+  std::atomic<int> idle_{0};
+  std::mutex idleMutex_;
+  std::condition_variable idleCond_;
+};
+
+#endif  // ENGINE_TASK_SCHEDULER_H
@@ -0,0 +1,215 @@
+#include "task_table.h"
+
+#include "simulation.h"
+#include "task_forks.h"
+#include "task_scheduler.h"
+
+namespace {
+
+// Этапы захвата ресурсов философом, как в режиме виртуального времени
+const int STAGE_STOPPER = 0;
+const int STAGE_FIRST = 1;
+const int STAGE_SECOND = 2;
+const int STAGE_EATING = 3;
+
+// Общее состояние задач философов
+struct TaskTable {
+  Table* table;
+  TaskScheduler* scheduler;
+  TaskForkTable* forks;
+};
+
+class PhilosopherTask : public Task {
+ public:
+  PhilosopherTask(TaskTable& shared, Philosopher& self)
+      : shared_(shared), self_(self) {}
+
+  void run() override;
+
+ private:
+  // Шаг, с которого задача продолжит работу
+  enum class Step { Think, Hungry, Acquire, Done };
+
+  void think();
+  void eat();
+  void acquire();
+  void release();
+  void give(TaskSemaphore& sem);
+  bool tryTakeFork(TaskSemaphore& fork);
+  void report(EventType type, int fork, int64_t value) {
+    shared_.table->report(self_, type, fork, value);
+  }
+
+  TaskTable& shared_;
+  Philosopher& self_;
+  Step step_ = Step::Think;
+  int acquired_ = STAGE_STOPPER;
+  std::chrono::steady_clock::time_point hungry_;
+};
+
+void PhilosopherTask::run() {
+  // После сигнала завершения задача больше не ставит себя в очередь
+  if (!shared_.table->running) return;
+
+  switch (step_) {
+    case Step::Think:
+      think();
+      break;
+    case Step::Hungry:
+      report(EventType::Hungry, -1, 0);
+      hungry_ = std::chrono::steady_clock::now();
+      acquired_ = STAGE_STOPPER;
+      acquire();
+      break;
+    case Step::Acquire:
+      acquire();
+      break;
+    case Step::Done:
+      report(EventType::PutDown, -1, 0);
+      release();
+      think();
+      break;
+  }
+}
+
+void PhilosopherTask::think() {
+  const Config& config = *shared_.table->config;
+  Duration thinkTime = self_.random.time(config.think());
+  report(EventType::Think, -1, thinkTime.count());
+  step_ = Step::Hungry;
+  shared_.scheduler->scheduleAt(this,
+                                std::chrono::steady_clock::now() + thinkTime);
+}
+
+void PhilosopherTask::eat() {
+  Table& table = *shared_.table;
+  table.recordWait(self_, std::chrono::steady_clock::now() - hungry_);
+  Duration eatTime = self_.random.time(table.config->eat());
+  report(EventType::Eat, -1, eatTime.count());
+  step_ = Step::Done;
+  shared_.scheduler->scheduleAt(this,
+                                std::chrono::steady_clock::now() + eatTime);
+}
+
+// Продвигает философа по этапам захвата, пока ресурсы свободны. Если ресурс
+// занят, задача остаётся в очереди семафора и продолжит с того же места,
+// когда give() передаст ей ресурс.
+void PhilosopherTask::acquire() {
+  TaskForkTable& forks = *shared_.forks;
+  int first = forks.first[self_.id];
+  int second = forks.second[self_.id];
+  step_ = Step::Acquire;
+  if (forks.protocol.bothForks && acquired_ != STAGE_EATING) {
+    report(EventType::TakeFork, first, 0);
+    report(EventType::TakeFork, second, 0);
+    // Если вилки заняты, их передаст сосед через putBoth()
+    acquired_ = STAGE_EATING;
+    // Занятость учитывается заранее, как в tryTakeFork()
+    self_.stats.count(EventType::ForkBusy, 0);
+    if (forks.monitor.tryTakeBoth(self_.id, this)) {
+      PhilosopherStats::add(self_.stats.busyForks, -1L);
+      eat();
+    }
+    return;
+  }
+
+  while (true) {
+    switch (acquired_) {
+      case STAGE_STOPPER:
+        if (forks.protocol.useStopper) {
+          report(EventType::WaitPermission, -1, 0);
+          if (!forks.stopper.tryAcquire(this)) {
+            return;
+          }
+        }
+        acquired_ = STAGE_FIRST;
+        break;
+      case STAGE_FIRST:
+        report(EventType::TakeFork, first, 0);
+        if (!tryTakeFork(forks.forks[first])) {
+          return;
+        }
+        acquired_ = STAGE_SECOND;
+        break;
+      case STAGE_SECOND:
+        report(EventType::TakeFork, second, 0);
+        if (!tryTakeFork(forks.forks[second])) {
+          return;
+        }
+        acquired_ = STAGE_EATING;
+        break;
+      default:
+        eat();
+        return;
+    }
+  }
+}
+
+// Берёт вилку или ставит задачу в её очередь. Занятая вилка учитывается
+// заранее: после постановки в очередь задачу может продолжить другой рабочий
+// поток, и трогать её счётчики отсюда уже нельзя.
+bool PhilosopherTask::tryTakeFork(TaskSemaphore& fork) {
+  self_.stats.count(EventType::ForkBusy, 0);
+  if (!fork.tryAcquire(this)) {
+    return false;
+  }
+  PhilosopherStats::add(self_.stats.busyForks, -1L);
+  return true;
+}
+
+void PhilosopherTask::release() {
+  TaskForkTable& forks = *shared_.forks;
+  if (forks.protocol.bothForks) {
+    Task* woken[2];
+    int count = forks.monitor.putBoth(self_.id, woken);
+    for (int i = 0; i < count; ++i) {
+      shared_.scheduler->schedule(woken[i]);
+    }
+    return;
+  }
+
+  give(forks.forks[forks.second[self_.id]]);
+  give(forks.forks[forks.first[self_.id]]);
+  if (forks.protocol.useStopper) {
+    give(forks.stopper);
+  }
+}
+
+// Аналог sem_post: ресурс сразу передаётся первому ожидающему, и его задача
+// снова становится готовой
+void PhilosopherTask::give(TaskSemaphore& sem) {
+  auto* waiter = static_cast<PhilosopherTask*>(sem.release());
+  if (waiter) {
+    ++waiter->acquired_;
+    shared_.scheduler->schedule(waiter);
+  }
+}
+
+}  // namespace
+
+void launchTasks(Table& table, std::vector<Philosopher>& philosophers) {
+  VirtualProtocol protocol{};
+  if (!table.arbiter->virtualProtocol(protocol)) {
+    table.print("Стратегия " + std::string(table.arbiter->name()) +
+                " не поддерживает режим задач.");
+    table.running.cancel();
+    return;
+  }
+
+  TaskScheduler scheduler(table.config->workers);
+  TaskForkTable forks((int)philosophers.size(), protocol);
+  TaskTable shared{&table, &scheduler, &forks};
+
+  std::vector<PhilosopherTask> tasks;
+  tasks.reserve(philosophers.size());
+  for (auto& philosopher : philosophers) {
+    tasks.emplace_back(shared, philosopher);
+  }
+
+  scheduler.start();
+  for (auto& task : tasks) {
+    scheduler.schedule(&task);
+  }
+  waitForTimeout(table);
+  scheduler.stop();
+}
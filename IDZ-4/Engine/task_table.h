@@ -0,0 +1,17 @@
+#ifndef ENGINE_TASK_TABLE_H
+#define ENGINE_TASK_TABLE_H
+
+#include <vector>
+
+#include "philosopher.h"
+
+// Режим задач (--tasks): философ - не поток, а конечный автомат на
+// планировщике M:N с рабочим потоком на процессор (config.workers). Вилки и
+// блокировщик - счётчики с очередями ожидающих, как в режиме виртуального
+// времени, но в реальном времени: занятая вилка ставит философа в очередь и
+// освобождает рабочий поток, а положивший вилку философ передаёт её первому
+// ожидающему и снова делает его готовым. Протокол захвата берётся из
+// ForkArbiter::virtualProtocol(); стратегия без протокола не запускается.
+void launchTasks(Table& table, std::vector<Philosopher>& philosophers);
+
+#endif  // ENGINE_TASK_TABLE_H
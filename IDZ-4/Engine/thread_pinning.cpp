@@ -0,0 +1,164 @@
+#include "thread_pinning.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+#include "numa_topology.h"
+
+namespace {
+
+// Первый процессор из списка sysfs по пути path или fallback
+int firstCpu(const std::string& path, int fallback) {
+  std::ifstream file(path);
+  std::string text;
+  std::vector<int> cpus;
+  if (std::getline(file, text) && parseCpuList(text, cpus) && !cpus.empty()) {
+    return cpus.front();
+  }
+  return fallback;
+}
+
+// Доступные процессу процессоры: комплексы ядер (группы с общим кэшем L3),
+// в них ядра, в ядрах гиперпотоки - всё по возрастанию номеров
+using Topology = std::vector<std::vector<std::vector<int>>>;
+
+Topology complexes() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  bool known = sched_getaffinity(0, sizeof(set), &set) == 0;
+  // Комплекс и ядро обозначаются первым своим процессором
+  std::map<int, std::map<int, std::vector<int>>> grouped;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (known ? !CPU_ISSET(cpu, &set) : cpu > 0) continue;
+    std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    int complex = firstCpu(base + "/cache/index3/shared_cpu_list", 0);
+    int core = firstCpu(base + "/topology/thread_siblings_list", cpu);
+    grouped[complex][core].push_back(cpu);
+  }
+
+  Topology result;
+  for (const auto& [complex, cores] : grouped) {
+    result.emplace_back();
+    for (const auto& [core, threads] : cores) {
+      result.back().push_back(threads);
+    }
+  }
+  return result;
+}
+
+// Процессоры комплекса: сначала первые гиперпотоки всех ядер, затем вторые,
+// чтобы соседние номера по возможности не делили одно ядро
+std::vector<int> spread(const std::vector<std::vector<int>>& cores) {
+  std::vector<int> order;
+  for (size_t thread = 0;; ++thread) {
+    size_t before = order.size();
+    for (const auto& threads : cores) {
+      if (thread < threads.size()) order.push_back(threads[thread]);
+    }
+    if (order.size() == before) return order;
+  }
+}
+
+}  // namespace
+
+bool parsePinPolicy(const std::string& name, PinPolicy& policy) {
+  if (name == "none") {
+    policy = PinPolicy::None;
+  } else if (name == "compact") {
+    policy = PinPolicy::Compact;
+  } else if (name == "scatter") {
+    policy = PinPolicy::Scatter;
+  } else if (name == "neighbours") {
+    policy = PinPolicy::Neighbours;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* pinPolicyName(PinPolicy policy) {
+  switch (policy) {
+    case PinPolicy::None:
+      return "none";
+    case PinPolicy::Compact:
+      return "compact";
+    case PinPolicy::Scatter:
+      return "scatter";
+    case PinPolicy::Neighbours:
+      return "neighbours";
+  }
+  return "?";
+}
+
+ThreadPlacement::ThreadPlacement(PinPolicy policy, int numPhilosophers)
+    : cpus_(numPhilosophers) {
+  if (policy == PinPolicy::None) return;
+  Topology topology = complexes();
+  if (topology.empty()) return;
+
+  std::vector<int> order;
+  switch (policy) {
+    case PinPolicy::None:
+      return;
+    case PinPolicy::Compact:
+      // Подряд: гиперпотоки ядра, ядра комплекса, комплексы
+      for (const auto& cores : topology) {
+        for (const auto& threads : cores) {
+          order.insert(order.end(), threads.begin(), threads.end());
+        }
+      }
+      break;
+    case PinPolicy::Scatter: {
+      // По кругу: по одному процессору из каждого комплекса
+      std::vector<std::vector<int>> groups;
+      size_t longest = 0;
+      for (const auto& cores : topology) {
+        groups.push_back(spread(cores));
+        longest = std::max(longest, groups.back().size());
+      }
+      for (size_t k = 0; k < longest; ++k) {
+        for (const auto& group : groups) {
+          if (k < group.size()) order.push_back(group[k]);
+        }
+      }
+      break;
+    }
+    case PinPolicy::Neighbours: {
+      // Длина блока мест пропорциональна числу процессоров комплекса
+      std::vector<std::vector<int>> groups;
+      size_t total = 0;
+      for (const auto& cores : topology) {
+        groups.push_back(spread(cores));
+        total += groups.back().size();
+      }
+      size_t before = 0;
+      for (const auto& group : groups) {
+        int first = (int)(before * numPhilosophers / total);
+        before += group.size();
+        int last = (int)(before * numPhilosophers / total);
+        for (int i = first; i < last; ++i) {
+          cpus_[i] = group;
+        }
+      }
+      return;
+    }
+  }
+  for (int i = 0; i < numPhilosophers; ++i) {
+    cpus_[i] = {order[i % order.size()]};
+  }
+}
+
+bool ThreadPlacement::bind(int philosopher) const {
+  const std::vector<int>& cpus = cpus_[philosopher];
+  if (cpus.empty()) return true;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,37 @@
+#ifndef ENGINE_THREAD_PINNING_H
+#define ENGINE_THREAD_PINNING_H
+
+#include <string>
+#include <vector>
+
+// Политика привязки потоков философов к процессорам
+enum class PinPolicy {
+  None,     // потоки свободно переносит планировщик ОС
+  Compact,  // философ i - на i-й процессор подряд: соседи делят ядро и L3
+  Scatter,  // соседи - на разных комплексах ядер (общих L3) по кругу
+  // Непрерывные блоки мест - на комплексы ядер; поток философа может
+  // работать на любом процессоре своего комплекса
+  Neighbours,
+};
+
+bool parsePinPolicy(const std::string& name, PinPolicy& policy);
+const char* pinPolicyName(PinPolicy policy);
+
+// Процессоры каждого философа по политике. Берутся только процессоры,
+// доступные процессу (sched_getaffinity); комплексы ядер - группы с общим
+// кэшем L3 по /sys/devices/system/cpu, без sysfs - один комплекс.
+class ThreadPlacement {
+ public:
+  ThreadPlacement(PinPolicy policy, int numPhilosophers);
+
+  const std::vector<int>& cpus(int philosopher) const {
+    return cpus_[philosopher];
+  }
+  // Привязывает текущий поток к процессорам философа; false - не удалось
+  bool bind(int philosopher) const;
+
+ private:
+  std::vector<std::vector<int>> cpus_;
+};
+
+#endif  // ENGINE_THREAD_PINNING_H
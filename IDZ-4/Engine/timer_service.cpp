@@ -0,0 +1,64 @@
+#include "timer_service.h"
+
+#include <sys/prctl.h>
+
+void usePreciseTimers() { prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0); }
+
+TimerService::~TimerService() { stop(); }
+
+void TimerService::start() {
+  thread_ = std::thread([this] { run(); });
+}
+
+void TimerService::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) return;
+    stopped_ = true;
+    expired_.clear();
+    wheel_.clear(expired_);
+    for (TimerWheel::Entry* entry : expired_) {
+      static_cast<Sleeper*>(entry)->cond.notify_one();
+    }
+    cond_.notify_one();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool TimerService::sleepUntil(Clock::time_point when) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stopped_) return false;
+
+  Sleeper sleeper;
+  wheel_.add(&sleeper, when);
+  // Новый срок раньше, чем поток службы собирался проснуться
+  if (when < plannedWake_) {
+    cond_.notify_one();
+  }
+  sleeper.cond.wait(lock, [&] { return sleeper.fired || stopped_; });
+  wheel_.remove(&sleeper);
+  return sleeper.fired;
+}
+
+void TimerService::run() {
+  usePreciseTimers();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_) {
+    expired_.clear();
+    wheel_.advance(Clock::now(), expired_);
+    for (TimerWheel::Entry* entry : expired_) {
+      auto* sleeper = static_cast<Sleeper*>(entry);
+      sleeper->fired = true;
+      sleeper->cond.notify_one();
+    }
+
+    plannedWake_ = wheel_.nextDeadline();
+    if (plannedWake_ == Clock::time_point::max()) {
+      cond_.wait(lock);
+    } else {
+      cond_.wait_until(lock, plannedWake_);
+    }
+  }
+}
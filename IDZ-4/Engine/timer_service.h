@@ -0,0 +1,57 @@
+#ifndef ENGINE_TIMER_SERVICE_H
+#define ENGINE_TIMER_SERVICE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "timer_wheel.h"
+
+// Служба таймеров для потоков философов. Поток регистрирует срок в общем
+// колесе таймеров и спит на собственной условной переменной; поток службы
+// спит до ближайшего срока колеса и будит ровно тех, чей срок наступил.
+// Спящий философ не просыпается, пока не истечёт его время или служба не
+// остановится.
+class TimerService {
+ public:
+  using Clock = TimerWheel::Clock;
+
+  TimerService() = default;
+  ~TimerService();
+
+  TimerService(const TimerService&) = delete;
+  TimerService& operator=(const TimerService&) = delete;
+
+  void start();
+  // Будит всех спящих и останавливает поток службы; после этого sleepUntil()
+  // сразу возвращает false
+  void stop();
+
+  // Спит до момента when. Возвращает false, если служба остановлена.
+  bool sleepUntil(Clock::time_point when);
+
+ private:
+  struct Sleeper : TimerWheel::Entry {
+    std::condition_variable cond;
+    bool fired = false;
+  };
+
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable cond_;  // будит поток службы
+  TimerWheel wheel_;
+  std::vector<TimerWheel::Entry*> expired_;
+  // Когда поток службы собирается проснуться сам
+  Clock::time_point plannedWake_ = Clock::time_point::max();
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
+// Снижает допуск таймеров ядра (timer slack, по умолчанию 50 мкс) для
+// вызывающего потока, чтобы ожидание до срока не затягивалось сверх такта
+// колеса
+void usePreciseTimers();
+
+#endif  // ENGINE_TIMER_SERVICE_H
@@ -0,0 +1,208 @@
+#include "timer_wheel.h"
+
+namespace {
+
+const uint64_t NO_TICK = UINT64_MAX;
+
+}  // namespace
+
+TimerWheel::TimerWheel(Clock::duration resolution, Clock::time_point start)
+    : resolution_(resolution), start_(start) {}
+
+// Такт срабатывания округляется вверх, чтобы таймер не сработал раньше срока
+uint64_t TimerWheel::toTick(Clock::time_point when) const {
+  if (when <= start_) return 0;
+  Clock::duration::rep elapsed = (when - start_).count();
+  Clock::duration::rep step = resolution_.count();
+  return (uint64_t)((elapsed + step - 1) / step);
+}
+
+TimerWheel::Clock::time_point TimerWheel::toTime(uint64_t tick) const {
+  return start_ + resolution_ * (Clock::duration::rep)tick;
+}
+
+void TimerWheel::add(Entry* entry, Clock::time_point when) {
+  if (entry->linked()) {
+    unlink(entry);
+    --size_;
+  }
+  entry->tick = toTick(when);
+  ++size_;
+  place(entry);
+}
+
+void TimerWheel::remove(Entry* entry) {
+  if (!entry->linked()) return;
+  unlink(entry);
+  --size_;
+}
+
+// Уровень таймера - первый, на котором номер блока таймера совпадает с
+// номером блока текущего такта на следующем уровне
+void TimerWheel::place(Entry* entry) {
+  if (entry->tick <= now_) {
+    link(LEVELS, 0, entry);
+    return;
+  }
+
+  // Верхний уровень покрывает SLOTS - 1 блоков вперёд; более далёкие
+  // таймеры ждут в последнем блоке и снова раскладываются при переносе
+  const int topShift = SLOT_BITS * (LEVELS - 1);
+  uint64_t tick = entry->tick;
+  uint64_t lastBlock = (now_ >> topShift) + SLOTS - 1;
+  if ((tick >> topShift) > lastBlock) {
+    tick = lastBlock << topShift;
+  }
+
+  for (int level = 0; level < LEVELS; ++level) {
+    int shift = SLOT_BITS * (level + 1);
+    if (level == LEVELS - 1 || (tick >> shift) == (now_ >> shift)) {
+      int slot = (int)((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+      link(level, slot, entry);
+      return;
+    }
+  }
+}
+
+void TimerWheel::link(int level, int slot, Entry* entry) {
+  Entry*& first = head(level, slot);
+  entry->level = (int16_t)level;
+  entry->slot = (int16_t)slot;
+  entry->prev = nullptr;
+  entry->next = first;
+  if (first) {
+    first->prev = entry;
+  }
+  first = entry;
+  if (level < LEVELS) {
+    occupied_[level][slot / 64] |= 1ull << (slot % 64);
+  }
+}
+
+void TimerWheel::unlink(Entry* entry) {
+  Entry*& first = head(entry->level, entry->slot);
+  if (entry->prev) {
+    entry->prev->next = entry->next;
+  } else {
+    first = entry->next;
+  }
+  if (entry->next) {
+    entry->next->prev = entry->prev;
+  }
+  if (!first && entry->level < LEVELS) {
+    occupied_[entry->level][entry->slot / 64] &=
+        ~(1ull << (entry->slot % 64));
+  }
+  entry->prev = nullptr;
+  entry->next = nullptr;
+  entry->level = -1;
+}
+
+TimerWheel::Entry* TimerWheel::take(int level, int slot) {
+  Entry*& first = head(level, slot);
+  Entry* list = first;
+  first = nullptr;
+  if (level < LEVELS) {
+    occupied_[level][slot / 64] &= ~(1ull << (slot % 64));
+  }
+  return list;
+}
+
+int TimerWheel::nextOccupied(int level, int after) const {
+  for (int slot = after + 1; slot < SLOTS;) {
+    int word = slot / 64;
+    uint64_t bits = occupied_[level][word] >> (slot % 64);
+    if (bits) {
+      return slot + __builtin_ctzll(bits);
+    }
+    slot = (word + 1) * 64;
+  }
+  return -1;
+}
+
+// На уровнях ниже верхнего все таймеры лежат в ячейках после текущей, и
+// таймеры нижнего уровня всегда раньше таймеров верхнего
+uint64_t TimerWheel::nextTick() const {
+  if (due_) return now_;
+  for (int level = 0; level < LEVELS; ++level) {
+    int shift = SLOT_BITS * level;
+    int current = (int)((now_ >> shift) & (SLOTS - 1));
+    uint64_t block = now_ >> (shift + SLOT_BITS);
+    int slot = nextOccupied(level, current);
+    if (slot < 0 && level == LEVELS - 1) {
+      // Верхний уровень закольцован: ячейки до текущей - следующий круг
+      slot = nextOccupied(level, -1);
+      ++block;
+    }
+    if (slot >= 0) {
+      return (block << (shift + SLOT_BITS)) | ((uint64_t)slot << shift);
+    }
+  }
+  return NO_TICK;
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextDeadline() const {
+  uint64_t tick = nextTick();
+  return tick == NO_TICK ? Clock::time_point::max() : toTime(tick);
+}
+
+void TimerWheel::advance(Clock::time_point now,
+                         std::vector<Entry*>& expired) {
+  uint64_t target =
+      now <= start_ ? 0 : (uint64_t)((now - start_) / resolution_);
+
+  while (true) {
+    // Сработавшие: ячейка текущего такта и список due_
+    for (Entry* list : {take(0, (int)(now_ & (SLOTS - 1))), take(LEVELS, 0)}) {
+      while (list) {
+        Entry* entry = list;
+        list = list->next;
+        entry->prev = nullptr;
+        entry->next = nullptr;
+        entry->level = -1;
+        --size_;
+        expired.push_back(entry);
+      }
+    }
+
+    // Пустые такты пропускаются сразу
+    uint64_t next = nextTick();
+    if (next == NO_TICK || next > target) {
+      if (target > now_) {
+        now_ = target;
+      }
+      return;
+    }
+    now_ = next;
+
+    // Перенос таймеров с верхних уровней, чей блок начинается в этом такте
+    for (int level = LEVELS - 1; level >= 1; --level) {
+      uint64_t mask = (1ull << (SLOT_BITS * level)) - 1;
+      if ((now_ & mask) != 0) continue;
+      int slot = (int)((now_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+      Entry* list = take(level, slot);
+      while (list) {
+        Entry* entry = list;
+        list = list->next;
+        place(entry);
+      }
+    }
+  }
+}
+
+void TimerWheel::clear(std::vector<Entry*>& entries) {
+  for (int level = 0; level <= LEVELS; ++level) {
+    for (int slot = 0; slot < (level < LEVELS ? SLOTS : 1); ++slot) {
+      Entry* list = take(level, slot);
+      while (list) {
+        Entry* entry = list;
+        list = list->next;
+        entry->prev = nullptr;
+        entry->next = nullptr;
+        entry->level = -1;
+        entries.push_back(entry);
+      }
+    }
+  }
+  size_ = 0;
+}
@@ -0,0 +1,89 @@
+#ifndef ENGINE_TIMER_WHEEL_H
+#define ENGINE_TIMER_WHEEL_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Иерархическое колесо таймеров (Varghese, Lauck).
+// Время делится на такты resolution; четыре уровня по 256 ячеек покрывают
+// 2^32 тактов (при 10 мкс - почти 12 часов). Таймер лежит на уровне,
+// начиная с которого номер его такта совпадает с текущим, поэтому добавление
+// и удаление стоят O(1), а таймер переносится на нижний уровень не больше
+// трёх раз. Битовые карты занятых ячеек позволяют перескочить пустые такты и
+// сразу найти ближайший срок. Записи встраиваются в объекты владельцев, само
+// колесо памяти не выделяет. Колесо не потокобезопасно: его защищает
+// владелец.
+class TimerWheel {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Запись таймера, встраиваемая в объект владельца
+  struct Entry {
+    Entry* prev = nullptr;
+    Entry* next = nullptr;
+    uint64_t tick = 0;  // такт срабатывания
+    // Где лежит запись: уровень (LEVELS - список due_) и ячейка; -1 - нигде
+    int16_t level = -1;
+    int16_t slot = 0;
+
+    bool linked() const { return level >= 0; }
+  };
+
+  static constexpr int LEVELS = 4;
+  static constexpr int SLOT_BITS = 8;
+  static constexpr int SLOTS = 1 << SLOT_BITS;
+  // Такт колеса по умолчанию
+  static constexpr std::chrono::microseconds DEFAULT_RESOLUTION{10};
+
+  explicit TimerWheel(
+      Clock::duration resolution = DEFAULT_RESOLUTION,
+      Clock::time_point start = Clock::now());
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Ставит таймер на момент when (с точностью до такта, не раньше when).
+  // Уже поставленная запись переставляется.
+  void add(Entry* entry, Clock::time_point when);
+  void remove(Entry* entry);
+
+  // Продвигает колесо до now и дописывает сработавшие записи в expired
+  void advance(Clock::time_point now, std::vector<Entry*>& expired);
+  // Извлекает все записи (например, при завершении)
+  void clear(std::vector<Entry*>& entries);
+
+  // Момент, к которому нужно вызвать advance(): ближайший срок или перенос
+  // таймеров с верхнего уровня. Clock::time_point::max(), если таймеров нет.
+  Clock::time_point nextDeadline() const;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+ private:
+  uint64_t toTick(Clock::time_point when) const;
+  Clock::time_point toTime(uint64_t tick) const;
+  void place(Entry* entry);
+  Entry*& head(int level, int slot) {
+    return level == LEVELS ? due_ : slots_[level][slot];
+  }
+  void link(int level, int slot, Entry* entry);
+  void unlink(Entry* entry);
+  // Отсоединяет и возвращает список ячейки
+  Entry* take(int level, int slot);
+  // Ближайший такт после now_, в который нужно что-то сделать, или
+  // UINT64_MAX
+  uint64_t nextTick() const;
+  int nextOccupied(int level, int after) const;
+
+  Clock::duration resolution_;
+  Clock::time_point start_;
+  uint64_t now_ = 0;  // последний обработанный такт
+  size_t size_ = 0;
+  Entry* slots_[LEVELS][SLOTS] = {};
+  uint64_t occupied_[LEVELS][SLOTS / 64] = {};
+  // Таймеры со сроком не позже now_: сработают при следующем advance()
+  Entry* due_ = nullptr;
+};
+
+#endif  // ENGINE_TIMER_WHEEL_H
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "chrome_trace.h"
+#include "event_trace.h"
+
+namespace {
+
+// Формат вывода трассы
+enum class Format { Log, Csv, Chrome };
+
+void printTraceUsage(const char* programName) {
+  std::cerr << "Использование: " << programName << " TRACE [флаги]\n"
+            << "  --csv             вывести CSV вместо журнала\n"
+            << "  --chrome          вывести JSON Chrome trace event\n"
+            << "                    (chrome://tracing, ui.perfetto.dev);\n"
+            << "                    дорожки вилок показывают только еду,\n"
+            << "                    без удержания вилки в ожидании второй\n"
+            << "  --log-timestamps  печатать номер и время каждого события\n";
+}
+
+}  // namespace
+
+// Печатает двоичную трассу (флаг --trace) в виде прежнего журнала, CSV или
+// JSON для просмотрщика. События читаются потоком, и трасса не обязана
+// помещаться в памяти.
+int main(int argc, char* argv[]) {
+  std::string path;
+  Format format = Format::Log;
+  bool timestamps = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--csv") {
+      format = Format::Csv;
+    } else if (arg == "--chrome") {
+      format = Format::Chrome;
+    } else if (arg == "--log-timestamps") {
+      timestamps = true;
+    } else if (path.empty() && arg.rfind("--", 0) != 0) {
+      path = arg;
+    } else {
+      printTraceUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (path.empty()) {
+    printTraceUsage(argv[0]);
+    return 1;
+  }
+
+  TraceReader reader;
+  if (!reader.open(path)) {
+    std::cerr << "Ошибка чтения трассы " << path << "\n";
+    return 1;
+  }
+
+  Event event{};
+  if (format == Format::Chrome) {
+    ChromeTraceExporter exporter(stdout);
+    while (reader.next(event)) {
+      exporter.add(event);
+    }
+    return exporter.finish() ? 0 : 1;
+  }
+
+  // Строки копятся в буфере и выводятся пачками
+  std::string out;
+  if (format == Format::Csv) {
+    out = "time_us,philosopher,event,fork,value_ns\n";
+  }
+  char line[64];
+  // Номер события считается, как в журнале: по напечатанным строкам
+  uint64_t printed = 0;
+  while (reader.next(event)) {
+    if (format == Format::Csv) {
+      std::snprintf(line, sizeof(line), "%lld,%d,%s,%d,%lld\n",
+                    (long long)event.time, event.philosopher,
+                    eventName(event.type), event.fork,
+                    (long long)event.value);
+      out += line;
+    } else {
+      std::string text = formatEvent(event, reader.logStyle());
+      if (text.empty()) continue;
+      if (timestamps) {
+        std::snprintf(line, sizeof(line), "[%llu +%.6f] ",
+                      (unsigned long long)printed, event.time / 1e6);
+        out += line;
+      }
+      ++printed;
+      out += text;
+      out += '\n';
+    }
+    if (out.size() >= (1 << 20)) {
+      std::fwrite(out.data(), 1, out.size(), stdout);
+      out.clear();
+    }
+  }
+  std::fwrite(out.data(), 1, out.size(), stdout);
+  return std::fflush(stdout) == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+#include "virtual_time.h"
+
+#include <algorithm>
+
+namespace {
+
+// Этапы захвата ресурсов философом (поле Philosopher::acquired)
+const int STAGE_STOPPER = 0;
+const int STAGE_FIRST = 1;
+const int STAGE_SECOND = 2;
+const int STAGE_EATING = 3;
+
+// Единица виртуального времени - наносекунда, в журнал идут микросекунды
+const int64_t NANOS_PER_MICRO = 1000;
+
+}  // namespace
+
+VirtualTimeSimulation::VirtualTimeSimulation(int numPhilosophers,
+                                             VirtualProtocol protocol,
+                                             PhaseTime think, PhaseTime eat,
+                                             uint64_t seed)
+    : numPhilosophers_(numPhilosophers),
+      protocol_(protocol),
+      think_(think),
+      eat_(eat),
+      stopper_{numPhilosophers - 1, {}},
+      forks_(numPhilosophers, Semaphore{1, {}}),
+      philosophers_(numPhilosophers),
+      meals_(numPhilosophers, 0) {
+  random_.reserve(numPhilosophers_);
+  for (int i = 0; i < numPhilosophers_; ++i) {
+    random_.emplace_back(seed, i);
+    int left = i;
+    int right = (i + 1) % numPhilosophers_;
+    if (protocol_.orderedForks) {
+      philosophers_[i].first = std::min(left, right);
+      philosophers_[i].second = std::max(left, right);
+    } else if (protocol_.oddRightFirst && i % 2 == 1) {
+      philosophers_[i].first = right;
+      philosophers_[i].second = left;
+    } else {
+      philosophers_[i].first = left;
+      philosophers_[i].second = right;
+    }
+    philosophers_[i].acquired = STAGE_STOPPER;
+    philosophers_[i].waiting = false;
+  }
+}
+
+bool VirtualTimeSimulation::run(Duration simulationTime,
+                                const EventSink& sink) {
+  sink_ = &sink;
+  for (int i = 0; i < numPhilosophers_; ++i) {
+    think(i);
+  }
+
+  while (!queue_.empty() && queue_.top().time <= simulationTime.count()) {
+    Scheduled next = queue_.top();
+    queue_.pop();
+    now_ = next.time;
+
+    switch (next.step) {
+      case Step::Hungry:
+        report(next.philosopher, EventType::Hungry, -1, 0);
+        philosophers_[next.philosopher].acquired = STAGE_STOPPER;
+        acquire(next.philosopher);
+        break;
+      case Step::Acquire:
+        acquire(next.philosopher);
+        break;
+      case Step::Done:
+        release(next.philosopher);
+        think(next.philosopher);
+        break;
+    }
+  }
+
+  sink_ = nullptr;
+  return !queue_.empty();
+}
+
+long VirtualTimeSimulation::totalMeals() const {
+  long total = 0;
+  for (long m : meals_) {
+    total += m;
+  }
+  return total;
+}
+
+void VirtualTimeSimulation::schedule(int64_t time, int philosopher,
+                                     Step step) {
+  queue_.push({time, nextSeq_++, philosopher, step});
+}
+
+void VirtualTimeSimulation::report(int philosopher, EventType type, int fork,
+                                   int64_t value) {
+  (*sink_)({now_ / NANOS_PER_MICRO, philosopher, type, fork, value});
+}
+
+void VirtualTimeSimulation::think(int philosopher) {
+  int64_t thinkTime = random_[philosopher].time(think_).count();
+  report(philosopher, EventType::Think, -1, thinkTime);
+  schedule(now_ + thinkTime, philosopher, Step::Hungry);
+}
+
+void VirtualTimeSimulation::eat(int philosopher) {
+  int64_t eatTime = random_[philosopher].time(eat_).count();
+  report(philosopher, EventType::Eat, -1, eatTime);
+  schedule(now_ + eatTime, philosopher, Step::Done);
+}
+
+// Продвигает философа по этапам захвата, пока ресурсы свободны. Если ресурс
+// занят, философ встаёт в очередь семафора и продолжит с того же места, когда
+// give() передаст ему ресурс.
+void VirtualTimeSimulation::acquire(int philosopher) {
+  Philosopher& p = philosophers_[philosopher];
+  if (protocol_.bothForks && p.acquired != STAGE_EATING) {
+    report(philosopher, EventType::TakeFork, p.first, 0);
+    report(philosopher, EventType::TakeFork, p.second, 0);
+    if (tryTakeBoth(philosopher)) {
+      eat(philosopher);
+    } else {
+      p.waiting = true;
+    }
+    return;
+  }
+
+  while (true) {
+    switch (p.acquired) {
+      case STAGE_STOPPER:
+        if (protocol_.useStopper) {
+          report(philosopher, EventType::WaitPermission, -1, 0);
+          if (!tryTake(stopper_, philosopher)) {
+            return;
+          }
+        }
+        p.acquired = STAGE_FIRST;
+        break;
+      case STAGE_FIRST:
+        report(philosopher, EventType::TakeFork, p.first, 0);
+        if (!tryTake(forks_[p.first], philosopher)) {
+          return;
+        }
+        p.acquired = STAGE_SECOND;
+        break;
+      case STAGE_SECOND:
+        report(philosopher, EventType::TakeFork, p.second, 0);
+        if (!tryTake(forks_[p.second], philosopher)) {
+          return;
+        }
+        p.acquired = STAGE_EATING;
+        break;
+      default:
+        eat(philosopher);
+        return;
+    }
+  }
+}
+
+void VirtualTimeSimulation::release(int philosopher) {
+  Philosopher& p = philosophers_[philosopher];
+  report(philosopher, EventType::PutDown, -1, 0);
+  ++meals_[philosopher];
+  give(forks_[p.second]);
+  give(forks_[p.first]);
+  if (protocol_.useStopper) {
+    give(stopper_);
+  }
+
+  // Освободившиеся вилки достаются ждущим соседям, если у них свободна и
+  // вторая вилка
+  if (protocol_.bothForks) {
+    int neighbours[] = {(philosopher + numPhilosophers_ - 1) % numPhilosophers_,
+                        (philosopher + 1) % numPhilosophers_};
+    for (int neighbour : neighbours) {
+      if (philosophers_[neighbour].waiting && tryTakeBoth(neighbour)) {
+        philosophers_[neighbour].waiting = false;
+        philosophers_[neighbour].acquired = STAGE_EATING;
+        schedule(now_, neighbour, Step::Acquire);
+      }
+    }
+  }
+}
+
+bool VirtualTimeSimulation::tryTake(Semaphore& sem, int philosopher) {
+  if (sem.count > 0) {
+    --sem.count;
+    return true;
+  }
+  sem.waiters.push_back(philosopher);
+  return false;
+}
+
+bool VirtualTimeSimulation::tryTakeBoth(int philosopher) {
+  Philosopher& p = philosophers_[philosopher];
+  if (forks_[p.first].count == 0 || forks_[p.second].count == 0) {
+    return false;
+  }
+  --forks_[p.first].count;
+  --forks_[p.second].count;
+  return true;
+}
+
+// Аналог sem_post: ресурс сразу передаётся первому ожидающему, который
+// продолжает захват в тот же момент виртуального времени
+void VirtualTimeSimulation::give(Semaphore& sem) {
+  if (sem.waiters.empty()) {
+    ++sem.count;
+    return;
+  }
+  int waiter = sem.waiters.front();
+  sem.waiters.pop_front();
+  ++philosophers_[waiter].acquired;
+  schedule(now_, waiter, Step::Acquire);
+}
@@ -0,0 +1,96 @@
+#ifndef ENGINE_VIRTUAL_TIME_H
+#define ENGINE_VIRTUAL_TIME_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "events.h"
+#include "random_source.h"
+
+// Протокол захвата вилок, воспроизводимый в виртуальном времени
+struct VirtualProtocol {
+  bool useStopper;    // семафор-блокировщик на (N - 1) разрешений
+  bool orderedForks;  // первой берётся вилка с меньшим номером
+  bool bothForks;     // обе вилки берутся разом, когда обе свободны
+  bool oddRightFirst;  // нечётные места берут первой правую вилку
+};
+
+// Дискретно-событийная симуляция обедающих философов.
+// Вместо потоков и sleep(1) все фазы философов - это события в очереди с
+// приоритетом по времени, а вилки и блокировщик - счётчики с очередями
+// ожидающих (FIFO, как у sem_wait). Симуляция простоя не стоит ничего, поэтому
+// 100 секунд модели проигрываются за миллисекунды.
+class VirtualTimeSimulation {
+ public:
+  using EventSink = std::function<void(const Event&)>;
+
+  VirtualTimeSimulation(int numPhilosophers, VirtualProtocol protocol,
+                        PhaseTime think, PhaseTime eat, uint64_t seed);
+
+  // Проигрывает модель до момента simulationTime, передавая события в sink.
+  // Возвращает false, если модель зашла в тупик (очередь событий опустела).
+  bool run(Duration simulationTime, const EventSink& sink);
+
+  long meals(int philosopher) const { return meals_[philosopher]; }
+  long totalMeals() const;
+
+ private:
+  // Шаг конечного автомата философа, на который указывает событие
+  enum class Step { Hungry, Acquire, Done };
+
+  struct Scheduled {
+    int64_t time;
+    uint64_t seq;  // порядок вставки для стабильности при равном времени
+    int philosopher;
+    Step step;
+
+    bool operator>(const Scheduled& other) const {
+      return time != other.time ? time > other.time : seq > other.seq;
+    }
+  };
+
+  // Счётный семафор модели с очередью ожидающих философов
+  struct Semaphore {
+    int count;
+    std::deque<int> waiters;
+  };
+
+  struct Philosopher {
+    int first;      // номер первой вилки
+    int second;     // номер второй вилки
+    int acquired;   // сколько ресурсов уже получено (блокировщик и вилки)
+    bool waiting;   // ждёт обе вилки разом (протокол bothForks)
+  };
+
+  void schedule(int64_t time, int philosopher, Step step);
+  void think(int philosopher);
+  void acquire(int philosopher);
+  void release(int philosopher);
+  void eat(int philosopher);
+  bool tryTakeBoth(int philosopher);
+  void report(int philosopher, EventType type, int fork, int64_t value);
+  bool tryTake(Semaphore& sem, int philosopher);
+  void give(Semaphore& sem);
+
+  int numPhilosophers_;
+  VirtualProtocol protocol_;
+  PhaseTime think_;
+  PhaseTime eat_;
+
+  int64_t now_ = 0;  // наносекунды модели
+  uint64_t nextSeq_ = 0;
+  const EventSink* sink_ = nullptr;
+  std::priority_queue<Scheduled, std::vector<Scheduled>,
+                      std::greater<Scheduled>>
+      queue_;
+  Semaphore stopper_;
+  std::vector<Semaphore> forks_;
+  std::vector<Philosopher> philosophers_;
+  std::vector<long> meals_;
+  std::vector<RandomSource> random_;  // генератор каждого философа
+};
+
+#endif  // ENGINE_VIRTUAL_TIME_H
@@ -0,0 +1,208 @@
+#include "waiter_arbiter.h"
+
+#include "futex.h"
+
+namespace {
+
+const int MAX_SPINS = 100;
+const uint32_t SLEEPING = 1;
+const uint32_t GRANTED = 2;
+// Вилки выданы не в той пачке, в которой пришла заявка
+const uint32_t WAITED = 4;
+const uint32_t CANCELLED = 1u << 31;
+
+}  // namespace
+
+WaiterArbiter::WaiterArbiter(int numPhilosophers, const char* name,
+                             int maxBypass)
+    : ForkArbiter(numPhilosophers),
+      name_(name),
+      maxBypass_(maxBypass),
+      seats_(numPhilosophers),
+      held_(numPhilosophers, false),
+      reserved_(numPhilosophers, false),
+      arrival_(numPhilosophers, 0),
+      bypassed_(numPhilosophers, 0),
+      neighbourGrants_(numPhilosophers, 0) {
+  for (int i = 0; i < numPhilosophers; ++i) {
+    seats_[i].request.philosopher = i;
+    seats_[i].release.philosopher = i;
+    seats_[i].release.release = true;
+  }
+  waiting_.reserve(numPhilosophers);
+  thread_ = std::thread([this] { run(); });
+}
+
+WaiterArbiter::~WaiterArbiter() {
+  stopping_ = true;
+  wake_.fetch_add(1, std::memory_order_release);
+  futexWakeOne(&wake_);
+  thread_.join();
+}
+
+bool WaiterArbiter::acquire(int philosopher, const CancellationToken& running,
+                            const EventReporter& report) {
+  report(EventType::TakeFork, leftFork(philosopher));
+  report(EventType::TakeFork, rightFork(philosopher));
+
+  // Сбрасываем прошлый ответ, не теряя отмены
+  Seat& seat = seats_[philosopher];
+  uint32_t state = seat.grant.load(std::memory_order_relaxed);
+  do {
+    if ((state & CANCELLED) || !running) return false;
+  } while (!seat.grant.compare_exchange_weak(state, 0,
+                                             std::memory_order_relaxed));
+  state = 0;
+  post(&seat.request);
+
+  // Арбитр обычно отвечает за микросекунды: сначала крутимся, потом спим
+  int limit = spinningHelps() ? MAX_SPINS : 0;
+  for (int spins = 0; spins < limit && state == 0; ++spins) {
+    cpuRelax();
+    state = seat.grant.load(std::memory_order_acquire);
+  }
+  while ((state & (GRANTED | CANCELLED)) == 0) {
+    // Бит SLEEPING говорит арбитру, что ответ нужно сопроводить futex wake
+    uint32_t expected = 0;
+    if (state == SLEEPING ||
+        seat.grant.compare_exchange_weak(expected, SLEEPING,
+                                         std::memory_order_relaxed)) {
+      futexWait(&seat.grant, SLEEPING);
+    }
+    state = seat.grant.load(std::memory_order_acquire);
+  }
+
+  if (state & CANCELLED) return false;
+  if (state & WAITED) {
+    report(EventType::ForkBusy, -1);
+  }
+  return true;
+}
+
+void WaiterArbiter::release(int philosopher) {
+  post(&seats_[philosopher].release);
+}
+
+// Будит только тот, кто положил сообщение в пустую очередь: иначе арбитр
+// и так заберёт его вместе с предыдущими
+void WaiterArbiter::post(Message* message) {
+  Message* head = head_.load(std::memory_order_relaxed);
+  do {
+    message->next = head;
+  } while (!head_.compare_exchange_weak(head, message,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed));
+  if (head == nullptr) {
+    wake_.fetch_add(1, std::memory_order_release);
+    futexWakeOne(&wake_);
+  }
+}
+
+void WaiterArbiter::cancel() {
+  for (Seat& seat : seats_) {
+    if (seat.grant.fetch_or(CANCELLED) & SLEEPING) {
+      futexWakeAll(&seat.grant);
+    }
+  }
+}
+
+void WaiterArbiter::run() {
+  while (!stopping_.load(std::memory_order_acquire)) {
+    uint32_t wake = wake_.load(std::memory_order_acquire);
+    Message* stack = head_.exchange(nullptr, std::memory_order_acquire);
+    if (stack == nullptr) {
+      // Сообщение, пришедшее после exchange, изменит wake_
+      futexWait(&wake_, wake);
+      continue;
+    }
+
+    // Стек хранит сообщения в обратном порядке
+    Message* batch = nullptr;
+    while (stack != nullptr) {
+      Message* next = stack->next;
+      stack->next = batch;
+      batch = stack;
+      stack = next;
+    }
+
+    ++batch_;
+    while (batch != nullptr) {
+      Message* next = batch->next;
+      int philosopher = batch->philosopher;
+      if (batch->release) {
+        held_[leftFork(philosopher)] = false;
+        held_[rightFork(philosopher)] = false;
+      } else {
+        waiting_.push_back({philosopher, batch_});
+        arrival_[philosopher] = ++arrivals_;
+        bypassed_[philosopher] = 0;
+        neighbourGrants_[philosopher] = 0;
+      }
+      batch = next;
+    }
+    grantWaiting();
+  }
+}
+
+// Список ждущих упорядочен по приходу заявок, поэтому дольше всех ждущий
+// получает вилки первым. Философ, чьи вилки заняты, не задерживает
+// следующих, пока не наберёт maxBypass_ обходов.
+void WaiterArbiter::grantWaiting() {
+  size_t kept = 0;
+  for (const Waiter& waiter : waiting_) {
+    int philosopher = waiter.philosopher;
+    int left = leftFork(philosopher);
+    int right = rightFork(philosopher);
+    if (held_[left] || held_[right] || reserved_[left] || reserved_[right]) {
+      waiting_[kept++] = waiter;
+      if (maxBypass_ != UNBOUNDED && bypassed_[philosopher] >= maxBypass_) {
+        reserve(philosopher);
+      }
+      continue;
+    }
+    held_[left] = true;
+    held_[right] = true;
+    uint64_t arrival = arrival_[philosopher];
+    arrival_[philosopher] = 0;
+    bypass((philosopher + numPhilosophers_ - 1) % numPhilosophers_, arrival);
+    if (numPhilosophers_ > 2) {
+      bypass((philosopher + 1) % numPhilosophers_, arrival);
+    }
+    if (neighbourGrants_[philosopher] >
+        maxNeighbourGrants_.load(std::memory_order_relaxed)) {
+      maxNeighbourGrants_.store(neighbourGrants_[philosopher],
+                                std::memory_order_relaxed);
+    }
+    Seat& seat = seats_[philosopher];
+    uint32_t answer = GRANTED | (waiter.batch != batch_ ? WAITED : 0);
+    if (seat.grant.fetch_or(answer, std::memory_order_release) & SLEEPING) {
+      futexWakeOne(&seat.grant);
+    }
+  }
+  waiting_.resize(kept);
+
+  for (int fork : reservedForks_) {
+    reserved_[fork] = false;
+  }
+  reservedForks_.clear();
+}
+
+// Старший сосед уже пройден в этой раздаче, поэтому, набрав предел, он
+// резервирует вилки сразу: иначе второй младший сосед обошёл бы его ещё раз
+void WaiterArbiter::bypass(int neighbour, uint64_t arrival) {
+  if (arrival_[neighbour] == 0) return;
+  ++neighbourGrants_[neighbour];
+  if (maxBypass_ == UNBOUNDED || arrival_[neighbour] > arrival) return;
+  if (++bypassed_[neighbour] >= maxBypass_) {
+    reserve(neighbour);
+  }
+}
+
+void WaiterArbiter::reserve(int philosopher) {
+  for (int fork : {leftFork(philosopher), rightFork(philosopher)}) {
+    if (!reserved_[fork]) {
+      reserved_[fork] = true;
+      reservedForks_.push_back(fork);
+    }
+  }
+}
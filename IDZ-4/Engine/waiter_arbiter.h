@@ -0,0 +1,98 @@
+#ifndef ENGINE_WAITER_ARBITER_H
+#define ENGINE_WAITER_ARBITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "fork_arbiter.h"
+
+// Официант: вилками распоряжается один поток-арбитр. Голодный философ
+// кладёт заявку в очередь без блокировок (много писателей, один читатель) и
+// засыпает на собственном слове futex. Арбитр забирает из очереди сразу всю
+// пачку заявок и возвратов, а затем раздаёт обе вилки разом, начиная с
+// дольше всех ждущих. Состояние вилок принадлежит только арбитру, поэтому
+// одно пробуждение арбитра обслуживает сколько угодно заявок без мьютекса.
+//
+// С ограничением maxBypass (стратегия aging) ожидание повышает приоритет:
+// каждый раз, когда младший по заявке сосед ест раньше ждущего, тот
+// получает обход, а набравший maxBypass обходов резервирует свои вилки, и
+// младшие заявки их больше не получат. Старше ждущего у каждого соседа
+// может быть только одна заявка, поэтому за одно ожидание соседи едят не
+// больше maxBypass + 2 раз. Без ограничения (стратегия waiter) младшие
+// соседи обходят ждущего без счёта.
+class WaiterArbiter : public ForkArbiter {
+ public:
+  // Без ограничения числа обходов
+  static constexpr int UNBOUNDED = -1;
+
+  WaiterArbiter(int numPhilosophers, const char* name,
+                int maxBypass = UNBOUNDED);
+  ~WaiterArbiter() override;
+
+  const char* name() const override { return name_; }
+  bool acquire(int philosopher, const CancellationToken& running,
+               const EventReporter& report) override;
+  void release(int philosopher) override;
+  void cancel() override;
+  long maxNeighbourMeals() const override {
+    return maxNeighbourGrants_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Заявка или возврат вилок; узлы заранее выделены у каждого философа
+  struct Message {
+    Message* next = nullptr;
+    int philosopher = 0;
+    bool release = false;
+  };
+
+  struct alignas(64) Seat {
+    // Ответ арбитра: биты GRANTED, WAITED, SLEEPING и CANCELLED
+    std::atomic<uint32_t> grant{0};
+    Message request;
+    Message release;
+  };
+
+  struct Waiter {
+    int philosopher;
+    uint64_t batch;  // пачка, в которой пришла заявка
+  };
+
+  void post(Message* message);
+  void run();
+  // Раздаёт вилки ждущим в порядке прихода заявок
+  void grantWaiting();
+  // Учитывает обед философа с номером заявки arrival у ждущего соседа: это
+  // обход, если сосед ждёт дольше
+  void bypass(int neighbour, uint64_t arrival);
+  // Закрывает вилки философа для младших заявок до конца раздачи
+  void reserve(int philosopher);
+
+  const char* name_;
+  const int maxBypass_;
+  std::vector<Seat> seats_;
+  // Вершина стека сообщений; арбитр забирает его целиком и переворачивает
+  alignas(64) std::atomic<Message*> head_{nullptr};
+  // Счётчик пробуждений арбитра: на нём он спит, когда очередь пуста
+  alignas(64) std::atomic<uint32_t> wake_{0};
+  std::atomic<bool> stopping_{false};
+
+  // Состояние арбитра, к нему обращается только его поток
+  std::vector<bool> held_;
+  std::vector<bool> reserved_;
+  std::vector<int> reservedForks_;  // чтобы сбросить reserved_ после раздачи
+  std::vector<Waiter> waiting_;
+  // Номер заявки ждущего философа (0 - не ждёт), число его обходов и
+  // всех обедов соседей за ожидание
+  std::vector<uint64_t> arrival_;
+  std::vector<int> bypassed_;
+  std::vector<long> neighbourGrants_;
+  std::atomic<long> maxNeighbourGrants_{0};
+  uint64_t arrivals_ = 0;
+  uint64_t batch_ = 0;
+  std::thread thread_;
+};
+
+#endif  // ENGINE_WAITER_ARBITER_H